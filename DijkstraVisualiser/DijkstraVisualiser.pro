@@ -5,7 +5,7 @@ TARGET = DijkstraVisualiser
 TEMPLATE = app
 
 # Build a static library
-CONFIG += staticlib
+CONFIG += staticlib c++17
 
 # Include the necessary directories
 INCLUDEPATH += .
@@ -15,15 +15,30 @@ DEPENDPATH += .
 SOURCES += main.cpp \
            widget.cpp \
            node.cpp \
-           edge.cpp
+           edge.cpp \
+           questionprefetcher.cpp \
+           renderstyle.cpp \
+           edgebatchitem.cpp \
+           graphtablemodel.cpp \
+           questionbankfile.cpp \
+           graphregionitem.cpp
 
 HEADERS += widget.h \
            node.h \
-           edge.h
+           edge.h \
+           questionprefetcher.h \
+           renderstyle.h \
+           edgebatchitem.h \
+           graphtablemodel.h \
+           questionbankfile.h \
+           graphregionitem.h
 
 FORMS += \
     widget.ui
 
+# Headless graph core
+include(../GraphCore/GraphCore.pri)
+
 
 
 # QT       += core gui
@@ -1,16 +1,19 @@
 #include "edge.h"
+#include "geometry.h"
 #include "node.h"
+#include "renderstyle.h"
+#include <QFontMetricsF>
 #include <QPainter>
+#include <QStyleOptionGraphicsItem>
 #include <QtMath>
 #include <QThread>
 #include <QLineF>
 
 // Edge constructor initializes an edge with source, destination nodes, directionality, and weight
 Edge::Edge(Node *sourceNode, Node *destNode, bool dir, int weight)
-    : source(sourceNode), dest(destNode), directed(dir), weight(weight)
+    : source(sourceNode), dest(destNode), directed(dir), weight(weight),
+      linePen(RenderStyle::edgePen(edgeColour))
 {
-    name.append(source->getName());
-    name.append(dest->getName());
     findPoints();
 }
 
@@ -29,7 +32,7 @@ Node *Edge::destNode() const {
 
 // Returns the name of the edge
 QString Edge::getName() {
-    return name;
+    return source->getName() + dest->getName();
 }
 
 // Returns the weight of the edge
@@ -45,6 +48,8 @@ bool Edge::isDirected() {
 // Sets the edge color and updates the display
 void Edge::setEdgeColour(const QColor &colour) {
     edgeColour = colour;
+    linePen = RenderStyle::edgePen(colour);
+    setVisible(!batched || edgeColour != Qt::black);
     update();
 }
 
@@ -63,33 +68,40 @@ QPointF Edge::getDestPoint() {
     return destPoint;
 }
 
-// Checks if this edge intersects with another edge
-bool Edge::intersects(const Edge &other) const {
-    QLineF thisLine(sourcePoint, destPoint);
-    QLineF otherLine(other.sourcePoint, other.destPoint);
+// Returns the id of the edge in the graph core
+int Edge::getId() {
+    return id;
+}
 
-    QPointF intersectionPoint;
-    if (thisLine.intersects(otherLine, &intersectionPoint) == QLineF::BoundedIntersection) {
-        // Lines intersect
-        return true;
-    }
-    return false;
+// Sets the id of the edge in the graph core
+void Edge::setId(int id) {
+    this->id = id;
+}
+
+// Marks the edge as drawn by a batch item; highlighted edges stay visible on top of the batch
+void Edge::setBatched(bool batched) {
+    this->batched = batched;
+    setVisible(!batched || edgeColour != Qt::black);
+}
+
+// Checks if this edge intersects with another edge, using the graph core test so pruning agrees with the drawing
+bool Edge::intersects(const Edge &other) const {
+    Segment thisLine{Point{sourcePoint.x(), sourcePoint.y()}, Point{destPoint.x(), destPoint.y()}};
+    Segment otherLine{Point{other.sourcePoint.x(), other.sourcePoint.y()}, Point{other.destPoint.x(), other.destPoint.y()}};
+    return segmentsIntersect(thisLine, otherLine);
 }
 
-// Calculates the source and destination points of the edge based on the source and destination nodes
+// Calculates the source and destination points of the edge based on the source and destination nodes,
+// trimmed exactly as the graph core trims the segments it prunes
 void Edge::findPoints() {
-    QLineF line(mapFromItem(source, 0, 0), mapFromItem(dest, 0, 0));
-    qreal length = line.length();
+    QPointF sourceCentre = mapFromItem(source, 0, 0);
+    QPointF destCentre = mapFromItem(dest, 0, 0);
+    Segment segment = edgeSegment(Point{sourceCentre.x(), sourceCentre.y()}, Point{destCentre.x(), destCentre.y()});
 
     prepareGeometryChange();
 
-    if (length > qreal(30.)) {
-        QPointF edgeOffset((line.dx() * 15) / length, (line.dy() * 15) / length);
-        sourcePoint = line.p1() + edgeOffset;
-        destPoint = line.p2() - edgeOffset;
-    } else {
-        sourcePoint = destPoint = line.p1();
-    }
+    sourcePoint = QPointF(segment.p1.x, segment.p1.y);
+    destPoint = QPointF(segment.p2.x, segment.p2.y);
 }
 
 // Returns the bounding rectangle for the edge
@@ -103,16 +115,22 @@ QRectF Edge::boundingRect() const {
         .adjusted(-extra, -extra, extra, extra);
 }
 
-// Paints the edge, including arrows if directed and weight if specified
+// Paints the edge, including arrows if directed and weight if specified. Arrows and weights are
+// culled when the view is zoomed out too far to read them.
 void Edge::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *) {
     QLineF line(sourcePoint, destPoint);
     if (qFuzzyCompare(line.length(), qreal(0.)))
         return;
 
     // Draw the line itself
-    painter->setPen(QPen(edgeColour, 1.8, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+    painter->setPen(linePen);
     painter->drawLine(line);
 
+    const qreal levelOfDetail = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    if (levelOfDetail < RenderStyle::DetailScale) {
+        return;
+    }
+
     // Draw the arrows
     if (directed) {
         double angle = std::atan2(-line.dy(), line.dx());
@@ -126,18 +144,18 @@ void Edge::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *)
         painter->drawPolygon(QPolygonF() << line.p2() << destArrowP1 << destArrowP2);
     }
 
-    // Draw the weight
+    // Draw the weight, with its baseline where the text used to be anchored. Like node labels, the weight
+    // text is laid out the first time it is drawn at a readable zoom and reused on every repaint after that.
     if (weight != 0) {
-        QFont font("Didot", 14);
-        font.setWeight(QFont::ExtraBold);
-        painter->setFont(font);
-        QPointF textPos = (line.pointAt(0.6));
-
-        // Draw the background text
-        painter->setPen(Qt::white);
-        painter->drawText(textPos, QString::number(weight));
-
-        painter->setPen(QPen(QColor("#E71D36"), 1.8, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
-        painter->drawText(textPos, QString::number(weight));
+        if (!weightPrepared) {
+            weightText.setText(QString::number(weight));
+            weightText.setPerformanceHint(QStaticText::AggressiveCaching);
+            weightText.prepare(QTransform(), RenderStyle::weightFont());
+            weightPrepared = true;
+        }
+        static const qreal ascent = QFontMetricsF(RenderStyle::weightFont()).ascent();
+        painter->setFont(RenderStyle::weightFont());
+        painter->setPen(RenderStyle::weightPen());
+        painter->drawStaticText(line.pointAt(0.6) - QPointF(0, ascent), weightText);
     }
 }
@@ -2,6 +2,8 @@
 #define EDGE_H
 
 #include <QGraphicsItem>
+#include <QPen>
+#include <QStaticText>
 
 class Node; // Forward declaration of the Node class
 
@@ -12,7 +14,7 @@ public:
 
     Node *sourceNode() const; // Getter for the source node
     Node *destNode() const; // Getter for the destination node
-    QString getName(); // Getter for the edge name
+    QString getName(); // Getter for the edge name, the labels of its two nodes
     int getWeight(); // Getter for the edge weight
     bool isDirected(); // Check if the edge is directed
     void setEdgeColour(const QColor &colour); // Setter for the edge colour
@@ -20,6 +22,9 @@ public:
     QPointF getSourcePoint(); // Getter for the source point of the edge
     QPointF getDestPoint(); // Getter for the destination point of the edge
     bool intersects(const Edge& other) const; // Check if the edge intersects with another edge
+    int getId(); // Getter for the edge id in the graph core
+    void setId(int id); // Setter for the edge id in the graph core
+    void setBatched(bool batched); // Hides the edge while an EdgeBatchItem draws it, unless it is highlighted
 
 protected:
     void findPoints(); // Helper function to find source and destination points
@@ -27,13 +32,17 @@ protected:
     QRectF boundingRect() const override; // Overridden boundingRect function
 
 private:
-    QString name; // Edge name
     Node *source, *dest; // Source and destination nodes
     QColor edgeColour = Qt::black; // Edge colour
     bool directed; // Flag indicating if the edge is directed
     int weight; // Edge weight
+    int id = -1; // Dense edge id in the graph core
     QPointF sourcePoint; // Source point of the edge
     QPointF destPoint; // Destination point of the edge
+    QPen linePen; // Pen for the line, rebuilt only when the colour changes
+    QStaticText weightText; // Weight label, empty until first drawn at a readable zoom, then reused on every repaint
+    bool weightPrepared = false; // Set once weightText holds the weight laid out with its font
+    bool batched = false; // Flag set while an EdgeBatchItem draws this edge
 };
 
 #endif // EDGE_H
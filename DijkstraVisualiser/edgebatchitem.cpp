@@ -0,0 +1,36 @@
+#include "edgebatchitem.h"
+#include "edge.h"
+#include "renderstyle.h"
+#include <QPainter>
+
+// EdgeBatchItem constructor collects the edge lines in scene coordinates
+EdgeBatchItem::EdgeBatchItem(const QList<Edge *> &edges) {
+    for (Edge *edge : edges) {
+        QPointF source = edge->mapToScene(edge->getSourcePoint());
+        QPointF dest = edge->mapToScene(edge->getDestPoint());
+        if (source != dest) {
+            lines.moveTo(source);
+            lines.lineTo(dest);
+        }
+    }
+    bounds = lines.boundingRect().adjusted(-2, -2, 2, 2);
+    setZValue(-1); // Keep highlighted edge items drawn on top
+    setCacheMode(QGraphicsItem::DeviceCoordinateCache); // Panning reuses the rendered lines
+}
+
+// Returns the bounds of the batched lines
+QRectF EdgeBatchItem::boundingRect() const {
+    return bounds;
+}
+
+// Returns the batched lines
+const QPainterPath &EdgeBatchItem::path() const {
+    return lines;
+}
+
+// Strokes every line with a single call
+void EdgeBatchItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *) {
+    painter->setPen(RenderStyle::edgePen(Qt::black));
+    painter->setBrush(Qt::NoBrush);
+    painter->drawPath(lines);
+}
@@ -0,0 +1,28 @@
+#ifndef EDGEBATCHITEM_H
+#define EDGEBATCHITEM_H
+
+#include <QGraphicsItem>
+#include <QList>
+#include <QPainterPath>
+
+class Edge; // Forward declaration of the Edge class
+
+// Draws the lines of many edges as one painter path, standing in for the individual edge items when a
+// large scene is zoomed out. Arrows and weights are not drawn, as they are culled at that zoom anyway.
+class EdgeBatchItem : public QGraphicsItem
+{
+public:
+    explicit EdgeBatchItem(const QList<Edge *> &edges);
+
+    QRectF boundingRect() const override; // Bounds of every batched line
+    const QPainterPath &path() const; // Lines of the batched edges
+
+protected:
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override; // Draws all lines at once
+
+private:
+    QPainterPath lines; // One subpath per edge
+    QRectF bounds; // Cached bounds of the lines, padded by the pen width
+};
+
+#endif // EDGEBATCHITEM_H
@@ -0,0 +1,124 @@
+#include "graphregionitem.h"
+#include "geometry.h"
+#include "renderstyle.h"
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <algorithm>
+
+namespace {
+
+// Centre to centre line of every edge, as drawn
+std::vector<Segment> edgeLines(const Graph &graph) {
+    std::vector<Segment> lines;
+    lines.reserve(size_t(graph.edgeCount()));
+    for (int id = 0; id < graph.edgeCount(); id++) {
+        lines.push_back(Segment{graph.position(graph.edge(id).source), graph.position(graph.edge(id).dest)});
+    }
+    return lines;
+}
+
+} // namespace
+
+// GraphRegionItem constructor takes the graph and indexes its nodes and edges in cells a few spacings wide
+GraphRegionItem::GraphRegionItem(Graph graph, double nodeSpacing)
+    : imported(std::move(graph)), grid(imported.positions(), 4 * nodeSpacing),
+      edgeGrid(edgeLines(imported), 4 * nodeSpacing), edgeMarks(size_t(imported.edgeCount()), 0)
+{
+    if (imported.nodeCount() > 0) {
+        double minX = imported.position(0).x, maxX = minX, minY = imported.position(0).y, maxY = minY;
+        for (const Point &p : imported.positions()) {
+            minX = std::min(minX, p.x);
+            maxX = std::max(maxX, p.x);
+            minY = std::min(minY, p.y);
+            maxY = std::max(maxY, p.y);
+        }
+        bounds = QRectF(QPointF(minX, minY), QPointF(maxX, maxY)).adjusted(-NodeRadius - 2, -NodeRadius - 2,
+                                                                         NodeRadius + 2, NodeRadius + 2);
+    }
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption); // Gives paint the exposed rectangle
+    setZValue(-1);
+}
+
+// Returns the bounds of the nodes
+QRectF GraphRegionItem::boundingRect() const {
+    return bounds;
+}
+
+// Returns the graph being drawn
+const Graph &GraphRegionItem::graph() const {
+    return imported;
+}
+
+// Returns the nodes whose centres lie in a rectangle, checking the grid's candidates exactly
+std::vector<int> GraphRegionItem::nodesIn(const QRectF &rect) const {
+    std::vector<int> nodes;
+    grid.forEachInRect(Point{rect.left(), rect.top()}, Point{rect.right(), rect.bottom()}, [&](int id) {
+        const Point &p = imported.position(id);
+        if (p.x >= rect.left() && p.x <= rect.right() && p.y >= rect.top() && p.y <= rect.bottom()) {
+            nodes.push_back(id);
+        }
+    });
+    return nodes;
+}
+
+// Returns the edges whose lines cross a rectangle, whether or not an end is inside it. Each edge is
+// checked exactly the first time one of its cells comes up, and the query stops once more than limit
+// edges are found, so a view too crowded to draw its edges costs no more than the limit.
+std::vector<int> GraphRegionItem::edgesIn(const QRectF &rect, int limit) const {
+    std::vector<int> edges;
+    if (++edgeQuery == 0) {
+        std::fill(edgeMarks.begin(), edgeMarks.end(), 0);
+        edgeQuery = 1;
+    }
+    const Point topLeft{rect.left(), rect.top()};
+    const Point bottomRight{rect.right(), rect.bottom()};
+    edgeGrid.forEachInRect(topLeft, bottomRight, [&](int id) {
+        if (edgeMarks[id] != edgeQuery) {
+            edgeMarks[id] = edgeQuery;
+            if (segmentIntersectsRect(edgeGrid.segment(id), topLeft, bottomRight)) {
+                edges.push_back(id);
+            }
+        }
+        return int(edges.size()) <= limit;
+    });
+    return edges;
+}
+
+// Draws the edges and nodes of the exposed region. Zoomed out, nodes become dots, and a region with
+// too many edges to draw at a useful frame rate shows its nodes alone.
+void GraphRegionItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *) {
+    const QRectF area = option->exposedRect.adjusted(-NodeRadius, -NodeRadius, NodeRadius, NodeRadius);
+    const std::vector<int> nodes = nodesIn(area);
+    const qreal levelOfDetail = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+
+    // Edges crossing the view, including those with both ends outside it
+    const std::vector<int> edges = edgesIn(area, RenderStyle::RegionEdgeCount);
+    if (int(edges.size()) <= RenderStyle::RegionEdgeCount) {
+        QVector<QLineF> lines;
+        lines.reserve(int(edges.size()));
+        for (int id : edges) {
+            const Segment &line = edgeGrid.segment(id);
+            lines.append(QLineF(line.p1.x, line.p1.y, line.p2.x, line.p2.y));
+        }
+        painter->setPen(RenderStyle::edgePen(Qt::black));
+        painter->drawLines(lines);
+    }
+
+    // Node circles, or a dot per node once the circles would be too small to see
+    const QColor &nodeColour = RenderStyle::nodeColour();
+    if (levelOfDetail < RenderStyle::OutlineScale) {
+        QVector<QPointF> points;
+        points.reserve(int(nodes.size()));
+        for (int node : nodes) {
+            points.append(QPointF(imported.position(node).x, imported.position(node).y));
+        }
+        painter->setPen(QPen(nodeColour, 2 * NodeRadius, Qt::SolidLine, Qt::RoundCap));
+        painter->drawPoints(points);
+        return;
+    }
+    painter->setPen(RenderStyle::nodeBorderPen());
+    painter->setBrush(nodeColour);
+    for (int node : nodes) {
+        painter->drawEllipse(QPointF(imported.position(node).x, imported.position(node).y), NodeRadius, NodeRadius);
+    }
+}
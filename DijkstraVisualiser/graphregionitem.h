@@ -0,0 +1,35 @@
+#ifndef GRAPHREGIONITEM_H
+#define GRAPHREGIONITEM_H
+
+#include "graph.h"
+#include "segmentgrid.h"
+#include "spatialgrid.h"
+#include <QGraphicsItem>
+#include <vector>
+
+// Draws an imported graph too large for an item per node and edge. The graph stays in the graph core
+// and each repaint asks spatial grids for the nodes and edges in the exposed part of the scene, so only
+// the visible region's coordinates ever reach the painter.
+class GraphRegionItem : public QGraphicsItem
+{
+public:
+    GraphRegionItem(Graph graph, double nodeSpacing);
+
+    QRectF boundingRect() const override; // Bounds of every node circle
+    const Graph &graph() const; // Graph being drawn
+    std::vector<int> nodesIn(const QRectF &rect) const; // Ids of the nodes whose centres lie in a scene rectangle
+    std::vector<int> edgesIn(const QRectF &rect, int limit) const; // Ids of the edges crossing a scene rectangle, once each, stopping past limit
+
+protected:
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override; // Draws the exposed nodes and their edges
+
+private:
+    Graph imported; // Imported graph, positions in scene coordinates
+    SpatialGrid grid; // Node positions bucketed for region queries
+    SegmentGrid edgeGrid; // Edge lines bucketed by the cells they cross
+    mutable std::vector<unsigned> edgeMarks; // Query each edge was last collected by, to skip its other cells
+    mutable unsigned edgeQuery = 0; // Number of edge queries made
+    QRectF bounds; // Cached bounds of the nodes, padded by the node radius
+};
+
+#endif // GRAPHREGIONITEM_H
@@ -0,0 +1,154 @@
+#include "graphtablemodel.h"
+#include <QBrush>
+#include <QColor>
+#include <algorithm>
+
+// GraphTableModel constructor starts with an empty table
+GraphTableModel::GraphTableModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+// Replaces the graph, resetting any attached view
+void GraphTableModel::setGraph(const Graph &graph, LabelStyle labelStyle) {
+    beginResetModel();
+    this->graph = graph;
+    this->labelStyle = labelStyle;
+    distances = layout == Representation::Distances ? allPairs(graph) : DistanceMatrix();
+    endResetModel();
+}
+
+// Drops the graph, leaving an empty table
+void GraphTableModel::clear() {
+    setGraph(Graph(), labelStyle);
+}
+
+// Switches the table between the matrix and list layouts
+void GraphTableModel::setRepresentation(Representation representation) {
+    if (representation == layout) {
+        return;
+    }
+    beginResetModel();
+    layout = representation;
+    if (layout == Representation::Distances && distances.nodeCount != graph.nodeCount()) {
+        distances = allPairs(graph);
+    }
+    endResetModel();
+}
+
+// Returns the current layout of the table
+Representation GraphTableModel::representation() const {
+    return layout;
+}
+
+// Hides one distance of the distance matrix, for the student to work out. On a graph with undirected
+// edges, or with an arc straight back, the way back is often as long as the way there, so the mirrored
+// cell is hidden as well rather than left to give the answer away.
+void GraphTableModel::setHiddenDistance(int from, int to) {
+    hiddenFrom = from;
+    hiddenTo = to;
+    hiddenBothWays = from >= 0 && to >= 0
+                     && (graph.findEdge(to, from) != -1
+                         || std::any_of(graph.edges().begin(), graph.edges().end(),
+                                        [](const GraphEdge &edge) { return !edge.directed; }));
+    if (layout == Representation::Distances && graph.nodeCount() > 0) {
+        emit dataChanged(index(0, 0), index(rowCount() - 1, columnCount() - 1));
+    }
+}
+
+// Looks the weight up in the node's arcs. With parallel edges the last arc wins, as in the old matrix.
+int GraphTableModel::weight(int from, int to) const {
+    int result = 0;
+    for (const Arc &arc : graph.outArcs(from)) {
+        if (arc.node == to) {
+            result = arc.weight;
+        }
+    }
+    return result;
+}
+
+// One row per node in both layouts
+int GraphTableModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : graph.nodeCount();
+}
+
+// One column per node for the matrix, a single neighbour column for the list
+int GraphTableModel::columnCount(const QModelIndex &parent) const {
+    if (parent.isValid() || graph.nodeCount() == 0) {
+        return 0;
+    }
+    return layout == Representation::List ? 1 : graph.nodeCount();
+}
+
+// Formats one cell, with the weights of existing edges in red
+QVariant GraphTableModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid()) {
+        return QVariant();
+    }
+
+    if (layout == Representation::List) {
+        if (role == Qt::DisplayRole) {
+            return neighbours(index.row());
+        }
+        return QVariant();
+    }
+    if (layout == Representation::Distances) {
+        return distanceData(index, role);
+    }
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return weight(index.row(), index.column());
+    case Qt::ForegroundRole:
+        return weight(index.row(), index.column()) != 0 ? QBrush(Qt::red) : QVariant();
+    case Qt::TextAlignmentRole:
+        return int(Qt::AlignCenter);
+    default:
+        return QVariant();
+    }
+}
+
+// Labels the rows and matrix columns with the node names
+QVariant GraphTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    if (orientation == Qt::Horizontal && layout == Representation::List) {
+        return QString("Neighbours");
+    }
+    return QString::fromStdString(nodeLabel(section, labelStyle));
+}
+
+// Lists the nodes a node's arcs lead to, each followed by the arc weight
+QString GraphTableModel::neighbours(int node) const {
+    std::string text;
+    for (const Arc &arc : graph.outArcs(node)) {
+        if (!text.empty()) {
+            text += ' ';
+        }
+        appendNodeLabel(text, arc.node, labelStyle);
+        text += '(' + std::to_string(arc.weight) + ')';
+    }
+    return QString::fromStdString(text);
+}
+
+// Formats a distance, with unreachable pairs as a dash and the hidden pair as a question mark in blue
+QVariant GraphTableModel::distanceData(const QModelIndex &index, int role) const {
+    const bool hidden = (index.row() == hiddenFrom && index.column() == hiddenTo)
+                        || (hiddenBothWays && index.row() == hiddenTo && index.column() == hiddenFrom);
+    switch (role) {
+    case Qt::DisplayRole: {
+        if (hidden) {
+            return QString("?");
+        }
+        const int distance = distances.at(index.row(), index.column());
+        return distance == Unreachable ? QVariant(QString("-")) : QVariant(distance);
+    }
+    case Qt::ForegroundRole:
+        return hidden ? QBrush(Qt::blue) : QVariant();
+    case Qt::TextAlignmentRole:
+        return int(Qt::AlignCenter);
+    default:
+        return QVariant();
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef GRAPHTABLEMODEL_H
+#define GRAPHTABLEMODEL_H
+
+#include "allpairs.h"
+#include "graph.h"
+#include "nodelabel.h"
+#include <QAbstractTableModel>
+
+// How the graph is laid out in the table
+enum class Representation {
+    Matrix, // One row and one column per node, cells hold the weight of the edge between them
+    List, // One row per node, listing the nodes its arcs lead to
+    Distances // One row and one column per node, cells hold the shortest distance between them
+};
+
+// Table model showing the graph as an adjacency matrix, an adjacency list or a distance matrix. Cells are
+// read from the graph's arcs when the view asks for them, so only the visible part of the table is ever
+// formatted and a large graph costs no more to show than a small one. The all-pairs distances are only
+// computed when the distance matrix is first shown.
+class GraphTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    explicit GraphTableModel(QObject *parent = nullptr);
+
+    void setGraph(const Graph &graph, LabelStyle labelStyle); // Shows a new graph
+    void clear(); // Shows an empty table
+    void setRepresentation(Representation representation); // Switches between the matrices and the list
+    Representation representation() const; // Current layout of the table
+    void setHiddenDistance(int from, int to); // Shows the distance from -> to, and to -> from where it gives it away, as "?"; -1 to show every distance
+    int weight(int from, int to) const; // Weight of the arc from -> to, 0 if there is none
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    QString neighbours(int node) const; // Adjacency list entry of a node
+    QVariant distanceData(const QModelIndex &index, int role) const; // Cell of the distance matrix
+
+    Graph graph; // Graph being shown
+    LabelStyle labelStyle = LabelStyle::Letters; // How nodes are labelled in the headers
+    Representation layout = Representation::Matrix; // Current layout of the table
+    DistanceMatrix distances; // All-pairs distances, empty until the distance matrix is shown
+    int hiddenFrom = -1; // Row of the distance left for the student to work out, -1 for none
+    int hiddenTo = -1; // Column of the hidden distance
+    bool hiddenBothWays = false; // Set when the mirrored cell is hidden too, as it can be travelled back along the same edges
+};
+
+#endif // GRAPHTABLEMODEL_H
@@ -1,12 +1,35 @@
 #include "widget.h"
 
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QDebug>
 #include <QFile>
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
+
+    // Describe the command line options
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addPositionalArgument("bank", "Question bank to serve questions from instead of generating them.", "[bank]");
+    QCommandLineOption graphOption({"g", "graph"}, "DIMACS .gr, MatrixMarket .mtx or edge list file to show.", "file");
+    parser.addOption(graphOption);
+    parser.process(a);
+
     Widget w;
+
+    // A question bank file given on the command line replaces the generator
+    const QStringList arguments = parser.positionalArguments();
+    if (!arguments.isEmpty() && !w.openQuestionBank(arguments.at(0))) {
+        qWarning() << "Could not open question bank" << arguments.at(0);
+    }
+
+    // An imported graph is shown in place of the first question
+    QString error;
+    if (parser.isSet(graphOption) && !w.openGraph(parser.value(graphOption), &error)) {
+        qWarning() << "Could not import" << parser.value(graphOption) << error;
+    }
     w.show();
     return a.exec();
 }
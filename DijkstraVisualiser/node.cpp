@@ -1,4 +1,5 @@
 #include "node.h"
+#include "renderstyle.h"
 
 #include <QGraphicsScene>
 #include <QGraphicsSceneMouseEvent>
@@ -6,8 +7,8 @@
 #include <QStyleOption>
 
 // Node constructor
-Node::Node(const char name, const int col)
-    : name(name), col(col)
+Node::Node(const int id, const int col, const LabelStyle labelStyle)
+    : id(id), col(col), labelStyle(labelStyle)
 {
 }
 
@@ -15,9 +16,12 @@ Node::Node(const char name, const int col)
 Node::~Node() {
 }
 
-// Returns the name of the node
-char Node::getName() {
-    return name;
+// Returns the label of the node, formatted from the id. Only nodes painted at a readable zoom keep a copy,
+// so a zoomed out large graph holds no string per node.
+QString Node::getName() const {
+    std::string label;
+    appendNodeLabel(label, id, labelStyle);
+    return QString::fromLatin1(label.data(), int(label.size()));
 }
 
 // Returns the color of the node
@@ -36,6 +40,11 @@ void Node::setNodeColour(const QColor &colour) {
     update();
 }
 
+// Returns the id of the node in the graph core
+int Node::getId() {
+    return id;
+}
+
 // Returns the shape of the node (ellipse)
 QPainterPath Node::shape() const {
     QPainterPath path;
@@ -49,19 +58,31 @@ QRectF Node::boundingRect() const {
     return QRectF( -10 - adjust, -10 - adjust, 23 + adjust, 23 + adjust);
 }
 
-// Paints the node with its color and name
+// Paints the node with its color and name. The name is culled when the view is zoomed out too far to
+// read it, and the border as well when zoomed out further.
 void Node::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *) {
+    const qreal levelOfDetail = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+
     // Draw the node circle with light fill color and black border
     painter->setBrush(nodeColour); // Light fill color
-    QPen borderPen(Qt::black);
-    borderPen.setWidth(1); // Set the width of the border
-    painter->setPen(borderPen); // Black border color
+    painter->setPen(levelOfDetail < RenderStyle::OutlineScale ? QPen(Qt::NoPen) : RenderStyle::nodeBorderPen());
     painter->drawEllipse(-15, -15, 30, 30); // Larger circle, adjust the size as needed
 
-    // Draw the node text
-    QFont font("Didot", 15, QFont::Bold); // Garamond font with size 10
+    if (levelOfDetail < RenderStyle::DetailScale) {
+        return;
+    }
+
+    // Draw the node text centred in the circle, shrinking longer labels to fit. The label is laid out the
+    // first time it is drawn, so its size is known, and reused on every repaint after that.
+    if (!labelPrepared) {
+        labelText.setText(getName());
+        labelText.setPerformanceHint(QStaticText::AggressiveCaching);
+        labelText.prepare(QTransform(), RenderStyle::nodeFont(labelText.text().size()));
+        labelPrepared = true;
+    }
+    const QFont &font = RenderStyle::nodeFont(labelText.text().size());
     painter->setFont(font);
-    QPen textPen(Qt::white, 0.5);
-    painter->setPen(textPen); // Set text color to black
-    painter->drawText(QRectF(-15, -14, 30, 30), Qt::AlignCenter, QString(name)); // Draw text
+    painter->setPen(RenderStyle::nodeTextPen());
+    const QSizeF size = labelText.size();
+    painter->drawStaticText(QPointF(-size.width() / 2, 1 - size.height() / 2), labelText);
 }
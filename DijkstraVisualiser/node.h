@@ -1,7 +1,10 @@
 #ifndef NODE_H
 #define NODE_H
 
+#include "nodelabel.h"
+#include "renderstyle.h"
 #include <QGraphicsItem>
+#include <QStaticText>
 #include <QVector>
 
 class Edge; // Forward declaration of the Edge class
@@ -10,13 +13,14 @@ class GraphVisualiserWidget; // Forward declaration of the GraphVisualiserWidget
 class Node : public QGraphicsItem
 {
 public:
-    Node(const char name = ' ', const int col = -1);
+    Node(const int id = -1, const int col = -1, const LabelStyle labelStyle = LabelStyle::Letters);
     ~Node();
 
-    char getName(); // Getter for the node name
+    QString getName() const; // Getter for the node label, formatted from the id when asked for
     int getCol(); // Getter for the node colour index
     QColor getNodeColour(); // Getter for the node colour
     void setNodeColour(const QColor &colour); // Setter for the node colour
+    int getId(); // Getter for the node id in the graph core
 
 protected:
     QRectF boundingRect() const override; // Overridden boundingRect function
@@ -24,9 +28,12 @@ protected:
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override; // Overridden paint function
 
 private:
-    const char name; // Node name
+    const int id; // Dense node id in the graph core
     const int col; // Node column
-    QColor nodeColour = QColor("#2C302E"); // Node colour
+    const LabelStyle labelStyle; // How the id is shown as a label
+    QColor nodeColour = RenderStyle::nodeColour(); // Node colour
+    QStaticText labelText; // Label, empty until first drawn at a readable zoom, then reused on every repaint
+    bool labelPrepared = false; // Set once labelText holds the label laid out with its font
 };
 
 #endif // NODE_H
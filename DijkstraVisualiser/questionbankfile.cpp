@@ -0,0 +1,60 @@
+#include "questionbankfile.h"
+
+// QuestionBankFile destructor unmaps the file
+QuestionBankFile::~QuestionBankFile() {
+    close();
+}
+
+// Maps the whole file read-only and checks its header
+bool QuestionBankFile::open(const QString &fileName) {
+    close();
+    file.setFileName(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    mapping = file.map(0, file.size());
+    if (!mapping) {
+        file.close();
+        return false;
+    }
+    view = QuestionBankView(mapping, size_t(file.size()));
+    if (!view.isValid()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+// Unmaps and closes the file
+void QuestionBankFile::close() {
+    view = QuestionBankView();
+    if (mapping) {
+        file.unmap(mapping);
+        mapping = nullptr;
+    }
+    file.close();
+}
+
+// Returns whether a valid bank is mapped
+bool QuestionBankFile::isOpen() const {
+    return view.isValid();
+}
+
+// Returns the number of questions in the bank
+int QuestionBankFile::count() const {
+    return view.questionCount();
+}
+
+// Copies a question out of the bank, with its graph built
+Question QuestionBankFile::question(int n) const {
+    return view.question(n);
+}
+
+// Returns the scene size recorded with a question, empty if the record is damaged
+QRectF QuestionBankFile::sceneRect(int n) const {
+    const BankRecord record = view.record(n);
+    if (!record.isValid()) {
+        return QRectF();
+    }
+    return QRectF(0, 0, record.header->sceneWidth, record.header->sceneHeight);
+}
@@ -0,0 +1,30 @@
+#ifndef QUESTIONBANKFILE_H
+#define QUESTIONBANKFILE_H
+
+#include "questionbank.h"
+#include <QFile>
+#include <QRectF>
+
+// A question bank file mapped into memory. Questions are read in place from the mapping, so opening
+// a bank of any size is instant and question n is found through the index without parsing the rest.
+class QuestionBankFile
+{
+public:
+    QuestionBankFile() = default;
+    ~QuestionBankFile();
+
+    bool open(const QString &fileName); // Maps a bank file, false if it cannot be read or is not a bank
+    void close(); // Unmaps the file
+    bool isOpen() const; // Set while a valid bank is mapped
+    int count() const; // Number of questions in the bank
+
+    Question question(int n) const; // Copies question n out of the bank
+    QRectF sceneRect(int n) const; // Scene the nodes of question n were placed in
+
+private:
+    QFile file; // Bank file, open while mapped
+    uchar *mapping = nullptr; // Mapped contents of the file
+    QuestionBankView view; // Index over the mapping
+};
+
+#endif // QUESTIONBANKFILE_H
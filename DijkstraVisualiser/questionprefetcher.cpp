@@ -0,0 +1,102 @@
+#include "questionprefetcher.h"
+#include <QMutexLocker>
+#include <QRandomGenerator>
+#include <QThread>
+#include <tuple>
+
+// PrefetchKey constructor picks out the settings that change the generated question
+PrefetchKey::PrefetchKey(const GeneratorConfig &config, SolverMode mode)
+    : graphType(config.graphType), directed(config.directed), proportionalWeights(config.proportionalWeights), mode(mode),
+      quizMode(config.quizMode)
+{
+}
+
+// Orders configurations for the ready queue lookup
+bool PrefetchKey::operator<(const PrefetchKey &other) const {
+    return std::tie(graphType, directed, proportionalWeights, mode, quizMode)
+           < std::tie(other.graphType, other.directed, other.proportionalWeights, other.mode, other.quizMode);
+}
+
+// QuestionPrefetcher constructor picks a random first seed and starts the worker thread, which idles
+// until a configuration is requested
+QuestionPrefetcher::QuestionPrefetcher(int depth, QObject *parent)
+    : QObject(parent), depth(depth), nextSeed(QRandomGenerator::global()->generate64())
+{
+    worker = QThread::create([this]() { run(); });
+    worker->start(QThread::LowPriority);
+}
+
+// QuestionPrefetcher destructor stops the worker, which finishes the question it is generating first
+QuestionPrefetcher::~QuestionPrefetcher() {
+    {
+        QMutexLocker locker(&mutex);
+        stopping = true;
+    }
+    wake.wakeAll();
+    worker->wait();
+    delete worker;
+}
+
+// Makes a configuration the one the worker keeps topped up
+void QuestionPrefetcher::setActive(const GeneratorConfig &config, SolverMode mode) {
+    QMutexLocker locker(&mutex);
+    activeKey = PrefetchKey(config, mode);
+    activeConfig = config;
+    hasActive = true;
+    wake.wakeAll();
+}
+
+// Takes the oldest ready question for a configuration. If none is ready yet it is generated on the
+// calling thread, so the caller never waits behind the worker.
+Question QuestionPrefetcher::take(const GeneratorConfig &config, SolverMode mode) {
+    setActive(config, mode);
+    uint64_t seed;
+    {
+        QMutexLocker locker(&mutex);
+        std::deque<Question> &queue = ready[activeKey];
+        if (!queue.empty()) {
+            Question question = std::move(queue.front());
+            queue.pop_front();
+            wake.wakeAll();
+            return question;
+        }
+        seed = nextSeed++;
+    }
+    return QuestionPipeline(config, mode).generate(seed);
+}
+
+// Returns how many questions are ready for a configuration
+int QuestionPrefetcher::readyCount(const GeneratorConfig &config, SolverMode mode) {
+    QMutexLocker locker(&mutex);
+    auto it = ready.find(PrefetchKey(config, mode));
+    return it == ready.end() ? 0 : int(it->second.size());
+}
+
+// Generates questions for the active configuration until its queue is full, then sleeps until one is taken
+void QuestionPrefetcher::run() {
+    for (;;) {
+        PrefetchKey key;
+        GeneratorConfig config;
+        uint64_t seed;
+        {
+            QMutexLocker locker(&mutex);
+            while (!stopping && (!hasActive || int(ready[activeKey].size()) >= depth)) {
+                wake.wait(&mutex);
+            }
+            if (stopping) {
+                return;
+            }
+            key = activeKey;
+            config = activeConfig;
+            seed = nextSeed++;
+        }
+
+        // Generate outside the lock so the GUI thread can keep taking questions
+        Question question = QuestionPipeline(config, key.mode).generate(seed);
+
+        QMutexLocker locker(&mutex);
+        if (int(ready[key].size()) < depth) {
+            ready[key].push_back(std::move(question));
+        }
+    }
+}
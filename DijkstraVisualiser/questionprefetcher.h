@@ -0,0 +1,56 @@
+#ifndef QUESTIONPREFETCHER_H
+#define QUESTIONPREFETCHER_H
+
+#include "question.h"
+#include <QMutex>
+#include <QObject>
+#include <QWaitCondition>
+#include <deque>
+#include <map>
+
+class QThread; // Forward declaration of the QThread class
+
+// Identifies the settings a question was generated for
+struct PrefetchKey {
+    int graphType = 0; // Graph type combo box index
+    bool directed = false; // Directed checkbox state
+    bool proportionalWeights = false; // Length weights checkbox state
+    SolverMode mode = SolverMode::Dijkstra; // Solver combo box selection
+    QuizMode quizMode = QuizMode::ShortestPath; // Quiz mode combo box selection
+
+    PrefetchKey() = default;
+    PrefetchKey(const GeneratorConfig &config, SolverMode mode);
+    bool operator<(const PrefetchKey &other) const;
+};
+
+// Generates questions on a worker thread ahead of time, keeping a small ready queue per configuration.
+// The worker tops up the queue of the configuration currently on screen; queues of other
+// configurations are kept so switching back is instant too.
+class QuestionPrefetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit QuestionPrefetcher(int depth = 3, QObject *parent = nullptr);
+    ~QuestionPrefetcher();
+
+    void setActive(const GeneratorConfig &config, SolverMode mode); // Points the worker at a configuration
+    Question take(const GeneratorConfig &config, SolverMode mode); // Takes a ready question, generating one if the queue is empty
+    int readyCount(const GeneratorConfig &config, SolverMode mode); // Number of ready questions for a configuration
+
+private:
+    void run(); // Body of the worker thread
+
+    const int depth; // Number of questions to keep ready per configuration
+    QMutex mutex; // Guards every member below
+    QWaitCondition wake; // Signals the worker that a queue needs topping up
+    std::map<PrefetchKey, std::deque<Question>> ready; // Ready questions per configuration
+    PrefetchKey activeKey; // Configuration the worker fills
+    GeneratorConfig activeConfig; // Generation options of the active configuration
+    bool hasActive = false; // Set once a configuration has been requested
+    bool stopping = false; // Set when the prefetcher is destroyed
+    uint64_t nextSeed; // Seed of the next question generated, counting up from a random start
+    QThread *worker = nullptr; // Worker thread
+};
+
+#endif // QUESTIONPREFETCHER_H
@@ -0,0 +1,56 @@
+#include "renderstyle.h"
+
+namespace RenderStyle {
+
+// Returns the weight label font
+const QFont &weightFont() {
+    static const QFont font = [] {
+        QFont f("Didot", 14);
+        f.setWeight(QFont::ExtraBold);
+        return f;
+    }();
+    return font;
+}
+
+// Returns the node label font for a label length
+const QFont &nodeFont(int labelLength) {
+    static const QFont fonts[] = {QFont("Didot", 15, QFont::Bold), QFont("Didot", 11, QFont::Bold), QFont("Didot", 8, QFont::Bold)};
+    return fonts[qBound(1, labelLength, 3) - 1];
+}
+
+// Returns the node border pen
+const QPen &nodeBorderPen() {
+    static const QPen pen(Qt::black, 1);
+    return pen;
+}
+
+// Returns the node label pen
+const QPen &nodeTextPen() {
+    static const QPen pen(Qt::white, 0.5);
+    return pen;
+}
+
+// Returns the weight label pen
+const QPen &weightPen() {
+    static const QPen pen(QColor("#E71D36"), 1.8, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
+    return pen;
+}
+
+// Returns the line pen of an edge
+QPen edgePen(const QColor &colour) {
+    return QPen(colour, 1.8, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
+}
+
+// Returns the plain node fill
+const QColor &nodeColour() {
+    static const QColor colour("#2C302E");
+    return colour;
+}
+
+// Returns the fill of the question's end nodes
+const QColor &endpointColour() {
+    static const QColor colour("#09814A");
+    return colour;
+}
+
+}
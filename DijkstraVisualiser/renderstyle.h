@@ -0,0 +1,27 @@
+#ifndef RENDERSTYLE_H
+#define RENDERSTYLE_H
+
+#include <QColor>
+#include <QFont>
+#include <QPen>
+
+// Pens, fonts and zoom thresholds shared by every scene item, created once instead of on each repaint
+namespace RenderStyle {
+
+constexpr qreal DetailScale = 0.6; // Below this zoom, weight labels, arrows and node text are culled
+constexpr qreal OutlineScale = 0.3; // Below this zoom, node borders are culled as well
+constexpr int BatchEdgeCount = 400; // Scenes with more edges draw them as one batched path when zoomed out
+constexpr int RegionEdgeCount = 200000; // An imported graph showing more edges than this draws only its nodes
+
+const QFont &weightFont(); // Font of the edge weight labels
+const QFont &nodeFont(int labelLength); // Font of a node label, smaller for longer labels
+const QPen &nodeBorderPen(); // Outline of a node circle
+const QPen &nodeTextPen(); // Colour of the node labels
+const QPen &weightPen(); // Colour of the edge weight labels
+QPen edgePen(const QColor &colour); // Line pen of an edge in a colour
+const QColor &nodeColour(); // Fill of a node that is neither highlighted nor an end of the question
+const QColor &endpointColour(); // Fill of the start node and the node a question asks about
+
+}
+
+#endif // RENDERSTYLE_H
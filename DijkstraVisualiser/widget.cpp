@@ -1,12 +1,14 @@
 #include "widget.h"
 #include "QtWidgets/qradiobutton.h"
 #include "edge.h"
+#include "graphimporter.h"
 #include "node.h"
+#include "renderstyle.h"
 #include "ui_widget.h"
 #include <QGraphicsScene>
+#include <QHeaderView>
 #include <QThread>
 #include <QRadioButton>
-#include <QRandomGenerator>
 #include <QWheelEvent>
 #include <QScrollBar>
 #include <QGraphicsItemAnimation>
@@ -15,21 +17,20 @@
 #include <QList>
 #include <queue>
 #include <map>
-#include <stack>
 #include <algorithm>
 
 
 // Constructor for the Widget class
 Widget::Widget(QWidget *parent)
-    : QWidget(parent), ui(new Ui::Widget)
+    : QWidget(parent), ui(new Ui::Widget), prefetcher(new QuestionPrefetcher(3, this)), graphModel(new GraphTableModel(this))
 {
     ui->setupUi(this); // Set up the user interface as defined in the .ui file
 
-    // Initialize the label array with alphabet characters for node labels
-    for (int i = 0; i < 26; i++){
-        char letter = 'A' + i;
-        labels[i] = letter;
-    }
+    // Show the graph in a table view; fixed section sizes keep the view from measuring every cell
+    ui->graphTableView->setModel(graphModel);
+    ui->graphTableView->horizontalHeader()->setDefaultSectionSize(32);
+    ui->graphTableView->verticalHeader()->setDefaultSectionSize(24);
+    ui->graphTableView->horizontalHeader()->setStretchLastSection(true);
 
     // Create a graphics scene for displaying the graph
     QGraphicsScene *scene = new QGraphicsScene(this);
@@ -38,9 +39,22 @@ Widget::Widget(QWidget *parent)
 
     ui->helpText->setHidden(true); // Initially hide the help text
 
-    // Connect UI elements to corresponding event handlers
-    connect(ui->comboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &Widget::on_nextGraphButton_clicked);
-    connect(ui->directedCheckBox, QOverload<int>::of(&QCheckBox::stateChanged), this, &Widget::on_nextGraphButton_clicked);
+    // Connect UI elements to corresponding event handlers; a settings change always starts a new graph,
+    // even partway through the questions asked on the current one
+    connect(ui->comboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &Widget::showNextGraph);
+    connect(ui->directedCheckBox, QOverload<int>::of(&QCheckBox::stateChanged), this, &Widget::showNextGraph);
+    connect(ui->proportionalCheckBox, QOverload<int>::of(&QCheckBox::stateChanged), this, &Widget::showNextGraph);
+    connect(ui->quizModeComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &Widget::showNextGraph);
+
+    // Switching the representation only changes how the current graph is laid out
+    connect(ui->representationComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int index) {
+        graphModel->setRepresentation(static_cast<Representation>(index));
+    });
+
+    // A solver change only affects upcoming questions, so start preparing those
+    connect(ui->solverComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this]() {
+        prefetcher->setActive(generatorConfig(ui->comboBox->currentIndex()), solverMode());
+    });
 
     // Generate the initial graph based on the current selection in the combo box
     generateGraph(ui->comboBox->currentIndex());
@@ -52,6 +66,43 @@ Widget::~Widget()
 }
 
 
+// Function that switches to serving the questions of a bank file in order, starting with the first
+bool Widget::openQuestionBank(const QString &fileName) {
+    if (!questionBank.open(fileName) || questionBank.count() == 0) {
+        questionBank.close();
+        return false;
+    }
+    nextBankQuestion = 0;
+    showNextGraph();
+    return true;
+}
+
+
+// Function that replaces the question with a graph imported from a DIMACS, MatrixMarket or edge list
+// file. The graph is drawn by one item that only paints the region in view; the next graph button
+// returns to the quiz.
+bool Widget::openGraph(const QString &fileName, QString *error) {
+    const ImportOptions options;
+    ImportResult result = importGraphFile(fileName.toStdString(), options);
+    if (!result.ok()) {
+        if (error) {
+            *error = QString::fromStdString(result.error);
+        }
+        return false;
+    }
+
+    resetScreen(); // Reset the screen layout
+    ui->submitButton->setDisabled(true); // There is no question to answer
+    ui->nextGraphButton->setEnabled(true); // The next graph button goes back to the quiz
+    importedGraph = new GraphRegionItem(std::move(result.graph), options.nodeSpacing);
+    ui->graphicsView->scene()->setSceneRect(importedGraph->boundingRect());
+    ui->graphicsView->scene()->addItem(importedGraph);
+    ui->resultLabel->setText(QString("%1 nodes, %2 edges").arg(importedGraph->graph().nodeCount())
+                                 .arg(importedGraph->graph().edgeCount()));
+    return true;
+}
+
+
 void Widget::on_helpButton_clicked()
 {
     if (ui->helpText->isHidden()){
@@ -73,8 +124,8 @@ void Widget::on_submitButton_clicked() {
             QRadioButton *answer = qobject_cast<QRadioButton *>(item->widget()); // Cast the widget to a radio button
             // Check if the radio button exists and is checked
             if (answer && answer->isChecked()) {
-                // Check if the selected answer is correct
-                if (correctAnswer == answer->text()) {
+                // Check if the selected answer is correct; any path as short as the answer is
+                if (acceptedAnswers.contains(answer->text())) {
                     // Correct answer
                     ui->resultLabel->setText("Correct!"); // Set the result label text to "Correct!"
                     ui->submitButton->setDisabled(true); // Disable the submit button
@@ -104,8 +155,19 @@ void Widget::on_submitButton_clicked() {
 }
 
 
-// Function to handle the next graph button click event
+// Function to handle the next graph button click event. A multi-destination round asks its remaining
+// questions on the graph already on screen before moving on to a new one.
 void Widget::on_nextGraphButton_clicked() {
+    if (nextDestination < int(destinations.size())) {
+        presentDestination(destinations[nextDestination++]);
+        return;
+    }
+    showNextGraph();
+}
+
+
+// Function that replaces the question on screen with one on a new graph
+void Widget::showNextGraph() {
     try {
         resetScreen(); // Reset the screen layout
         ui->submitButton->setDisabled(false); // Enable the submit button
@@ -119,13 +181,46 @@ void Widget::on_nextGraphButton_clicked() {
 }
 
 
-// Function to reset the screen and clear all displayed content
+// Function to regenerate the question for the seed typed into the seed box
+void Widget::on_seedLineEdit_returnPressed() {
+    bool ok = false;
+    const quint64 seed = ui->seedLineEdit->text().trimmed().toULongLong(&ok);
+    if (!ok) {
+        return;
+    }
+
+    resetScreen(); // Reset the screen layout
+    ui->submitButton->setDisabled(false); // Enable the submit button
+    ui->nextGraphButton->setDisabled(true); // Disable the next graph button until the question is answered
+    const GeneratorConfig config = generatorConfig(ui->comboBox->currentIndex());
+    ui->graphicsView->scene()->setSceneRect(0, 0, config.sceneWidth, config.sceneHeight);
+    presentQuestion(QuestionPipeline(config, solverMode()).generate(seed));
+}
+
+
+// Function to reset the screen and clear all displayed content. The scene owns every item of the
+// question on screen, so one clear releases them together; the scene itself is kept for the next question.
+// Every pointer into the scene is dropped straight after, so none outlives the item it points to.
 void Widget::resetScreen() {
-    // Create a new graphics scene for rendering the graph
-    QGraphicsScene *scene = new QGraphicsScene(this);
+    QGraphicsScene *scene = ui->graphicsView->scene();
+    scene->clear(); // Deletes the node, edge, batch and imported graph items
     scene->setSceneRect(0, 0, sceneWidth, sceneHeight); // Set the dimensions of the scene
-    ui->graphicsView->setScene(scene); // Assign the scene to the graphics view widget
+    pathTree = SearchResult();
+    pathStartNode = -1;
+    pathEndNode = -1;
+    destinations.clear();
+    nextDestination = 0;
+    nodeItems.clear();
+    edgeItems.clear();
+    edgeBatch = nullptr;
+    importedGraph = nullptr;
+    clearChoices();
+    graphModel->clear(); // Clear the adjacency table
+}
 
+
+// Function that removes the answer options and the result of the last answer
+void Widget::clearChoices() {
     // Clear all items from the vertical layout
     QLayoutItem *child;
     while ((child = ui->verticalLayout->takeAt(0)) != nullptr) {
@@ -137,563 +232,248 @@ void Widget::resetScreen() {
 
     ui->verticalLayout->setEnabled(true); // Enable the vertical layout
     ui->resultLabel->clear(); // Clear the result label text
-    ui->textBrowser->clear(); // Clear the text browser content
 }
 
 
 // Function to generate a new graph based on the selected graph type
 void Widget::generateGraph(int graphType) {
-    int numOfColumns; // Variable to store the number of columns in the graph
-    QList<Node *> allNodes; // List to store all nodes in the graph
-    QList<Edge *> allEdges; // List to store all edges in the graph
-
-    do {
-        // Determine the number of columns based on the graph type
-        numOfColumns = graphType == 0 ? QRandomGenerator::global()->bounded(3, 5) : QRandomGenerator::global()->bounded(4, 7);
-
-        // Generate nodes for the graph
-        allNodes = generateNodes(graphType, numOfColumns);
-
-        // Generate edges for the graph
-        allEdges = generateEdges(allNodes, graphType);
-
-        // Remove edges with high intersections to improve graph readability
-        removeEdgesWithHighIntersections(allEdges, 2);
-
-        // Remove nodes intersecting with edges to improve graph layout
-        removeNodeIntersectingEdges(allNodes, allEdges);
-
-        // Find the shortest path in the graph using Dijkstra's algorithm
-        shortestPath = dijkstrasAlgorithm(allNodes.first(), allNodes.last(), allNodes, allEdges);
-    } while (shortestPath.size() < 2); // Repeat until a valid shortest path is found
+    // A bank supplies its questions in order, wrapping around at the end
+    if (questionBank.isOpen()) {
+        const int n = nextBankQuestion++ % questionBank.count();
+        ui->graphicsView->scene()->setSceneRect(questionBank.sceneRect(n));
+        presentQuestion(questionBank.question(n));
+        return;
+    }
 
-    // Generate a question based on the shortest path
-    generateQuestion(shortestPath, allNodes, allEdges);
+    // Take a question the background worker prepared for the current settings; the worker then
+    // starts on the next one while this one is on screen
+    const GeneratorConfig config = generatorConfig(graphType);
+    Question question = prefetcher->take(config, solverMode());
+    ui->graphicsView->scene()->setSceneRect(0, 0, config.sceneWidth, config.sceneHeight);
 
-    // Add nodes and edges to the graphics scene
-    for (Node *n : allNodes) {
-        ui->graphicsView->scene()->addItem(n);
-    }
-    for (Edge *e : allEdges) {
-        ui->graphicsView->scene()->addItem(e);
-    }
+    // Show the question on screen
+    presentQuestion(question);
 }
 
 
-// Function to generate nodes for the graph
-QList<Node *> Widget::generateNodes(int graphType, const int numOfColumns) {
-    int numOfNodes = 0; // Variable to keep track of the total number of nodes generated
-    QList<Node *> allNodes; // List to store all generated nodes
-    qreal xBase = (sceneWidth - 20) / (numOfColumns + 1); // Calculate the base x-coordinate for node placement
-
-    // Loop through each column to generate nodes
-    for (int i = 0; i < numOfColumns; i++) {
-        qreal x = xBase * (i + 1); // Calculate the x-coordinate for the current column
+// Function that collects the generation options from the UI
+GeneratorConfig Widget::generatorConfig(int graphType) {
+    GeneratorConfig config;
+    config.graphType = graphType;
+    config.directed = ui->directedCheckBox->isChecked();
+    config.proportionalWeights = ui->proportionalCheckBox->isChecked();
+    config.quizMode = static_cast<QuizMode>(ui->quizModeComboBox->currentIndex());
+    config.sceneWidth = graphType == 2 ? largeSceneWidth : sceneWidth;
+    config.sceneHeight = graphType == 2 ? largeSceneHeight : sceneHeight;
+    config.labelStyle = graphType == 2 ? LabelStyle::Numbers : LabelStyle::Letters; // Hundreds of nodes read better as numbers
+    return config;
+}
 
-        // Determine the minimum and maximum number of nodes for the current column
-        int minNodes = (i == 0 || i == (numOfColumns - 1)) ? 1 : 2;
-        int maxNodes = (i == 0 || i == (numOfColumns - 1)) ?
-                           (graphType == 0 ? 3 : 4) : (graphType == 0 ? 4 : 6);
 
-        // Generate a random number of nodes for the current column within the specified range
-        int nodesInColumn = QRandomGenerator::global()->bounded(minNodes, maxNodes);
+// Function that returns the solver selected in the UI
+SolverMode Widget::solverMode() {
+    return static_cast<SolverMode>(ui->solverComboBox->currentIndex());
+}
 
-        // Calculate the base y-coordinate for node placement in the current column
-        qreal yBase = (sceneHeight - 20) / (nodesInColumn + 1);
 
-        // Loop through each node in the current column
-        for (int j = 0; j < nodesInColumn; j++) {
-            qreal y = yBase * (j + 1); // Calculate the y-coordinate for the current node
-            Node *newNode = new Node(labels[numOfNodes], i); // Create a new node with a label and column index
-            allNodes.append(newNode); // Add the new node to the list of all nodes
-            numOfNodes++; // Increment the total number of nodes generated
+// Function that builds the scene items for a generated question and shows its answer options
+void Widget::presentQuestion(const Question &question) {
+    const Graph &graph = question.graph;
+    QGraphicsScene *scene = ui->graphicsView->scene();
 
-            qreal perturb = QRandomGenerator::global()->bounded(-15, 15); // Generate a random perturbation value for node positioning
-            newNode->setPos(x + perturb, y + perturb); // Set the position of the new node with perturbation
-        }
+    // Create a node item for every node in the graph; each item goes into the scene as soon as it is
+    // made, so the next resetScreen releases it with the rest of the question
+    QList<Node *> allNodes;
+    for (int i = 0; i < graph.nodeCount(); i++) {
+        Node *newNode = new Node(i, question.columns[i], question.labelStyle);
+        newNode->setPos(graph.position(i).x, graph.position(i).y);
+        scene->addItem(newNode);
+        allNodes.append(newNode);
     }
 
     // Set the color of the start and end nodes
-    QColor startEndNodeColour = QColor("#09814A");
-    allNodes.first()->setNodeColour(startEndNodeColour); // Set color for the first node
-    allNodes.last()->setNodeColour(startEndNodeColour); // Set color for the last node
+    allNodes[question.startNode]->setNodeColour(RenderStyle::endpointColour());
+    allNodes[question.endNode]->setNodeColour(RenderStyle::endpointColour());
 
-    return allNodes; // Return the list of all generated nodes
-}
-
-
-// Function to generate edges for the graph
-QList<Edge *> Widget::generateEdges(QList<Node *> allNodes, const int graphType) {
-    // Check if the graph is directed
-    bool directed = ui->directedCheckBox->isChecked();
-
-    // List to store all generated edges
+    // Create an edge item for every edge, once the nodes are in place
     QList<Edge *> allEdges;
-
-    // Loop through each pair of adjacent nodes to create edges between them
-    for (int i = 0; i < allNodes.size() - 1; i++) {
-        Node *node1 = allNodes[i];
-        Node *node2 = allNodes[i + 1];
-
-        // Determine if the edge is directed based on the graph type and user input
-        bool directedProb = false;
-        if (directed) {
-            directedProb = graphType == 0 ? (QRandomGenerator::global()->bounded(1, 11) > 7 ? true : false)
-                                          : (QRandomGenerator::global()->bounded(1, 11) > 4 ? true : false);
-        }
-
-        // Generate a random weight for the edge
-        int weight = QRandomGenerator::global()->bounded(1, 15);
-
-        // Create a new edge between the current pair of nodes
-        Edge *newEdge = new Edge(node1, node2, directedProb, weight);
+    for (int id = 0; id < graph.edgeCount(); id++) {
+        const GraphEdge &e = graph.edge(id);
+        Edge *newEdge = new Edge(allNodes[e.source], allNodes[e.dest], e.directed, e.weight);
+        newEdge->setId(id);
+        scene->addItem(newEdge);
         allEdges.append(newEdge);
     }
 
-    // Loop through each node to potentially create additional edges
-    Node *node1;
-    Node *node2;
-    for (Node *node : allNodes) {
-        node1 = node;
-
-        QString potEdge;
-        QString potEdgeRev;
-        QList<Node *> nodesOfExistingEdges;
-        bool edgeExists = false;
-        bool fullGraph = false;
-
-        // Loop until all possible edges are created or the graph is full
-        do {
-            potEdge.clear();
-            potEdgeRev.clear();
-
-            int count = 0;
-            for (Node *n : allNodes) {
-                if (n->getName() == node1->getName() || nodesOfExistingEdges.contains(n)) {
-                    count++;
-                }
-            }
-            if (count == allNodes.size()) {
-                fullGraph = true;
-                break;
-            }
-
-            // Generate potential edges until a new edge can be created
-            do {
-                node2 = allNodes[QRandomGenerator::global()->bounded(allNodes.size())];
-            } while (node1->getName() == node2->getName() || nodesOfExistingEdges.contains(node2));
-            qreal shortestDist = QLineF(node1->pos(), node2->pos()).length();
-            for (Node *n : allNodes) {
-                if (n->getName() == node1->getName() || nodesOfExistingEdges.contains(n)) {
-                    continue;
-                }
-                qreal dist = QLineF(node1->pos(), n->pos()).length();
-                if (dist < shortestDist) {
-                    shortestDist = dist;
-                    node2 = n;
-                }
-            }
-
-            // Create the potential edge
-            potEdge.append(node1->getName());
-            potEdge.append(node2->getName());
-            for (int i = potEdge.length() - 1; i >= 0; --i) {
-                potEdgeRev.append(potEdge[i]);
-            }
-
-            // Check if the potential edge already exists
-            edgeExists = false;
-            for (Edge *e : allEdges) {
-                if (e->getName().compare(potEdge) == 0 || e->getName().compare(potEdgeRev) == 0) {
-                    edgeExists = true;
-                    nodesOfExistingEdges.append(node2);
-                    break;
-                }
-            }
-        } while (edgeExists);
-
-        // Break the loop if the graph is full
-        if (fullGraph) {
-            break;
-        } else {
-            // Determine if the edge is directed based on the graph type and user input
-            bool directedProb = false;
-            if (directed) {
-                directedProb = graphType == 0 ? (QRandomGenerator::global()->bounded(1, 11) > 7 ? true : false)
-                                              : (QRandomGenerator::global()->bounded(1, 11) > 4 ? true : false);
-            }
-
-            // Generate a random weight for the edge
-            int weight = QRandomGenerator::global()->bounded(1, 15);
-
-            // Create a new edge
-            Edge *newEdge = new Edge(node1, node2, directedProb, weight);
-            allEdges.append(newEdge);
-        }
+    // Generate a question based on the shortest path
+    nodeItems = allNodes;
+    edgeItems = allEdges;
+    generateQuestion(question);
+
+    // Large scenes also get one item drawing every edge line, used when zoomed out
+    if (allEdges.size() > RenderStyle::BatchEdgeCount) {
+        edgeBatch = new EdgeBatchItem(allEdges);
+        edgeBatch->setVisible(false); // Starts with the individual edges
+        scene->addItem(edgeBatch);
     }
-
-    return allEdges; // Return the list of all generated edges
+    updateLevelOfDetail();
 }
 
 
-// Function to remove edges with intersections above a limit
-void Widget::removeEdgesWithHighIntersections(QList<Edge*>& allEdges, int intersectionLimit) {
-    bool edgesRemoved;
-    do {
-        edgesRemoved = false;
-
-        // Create a map of edges and their intersection counts
-        QHash<Edge*, int> edgeIntersections;
-        for (Edge* edge : allEdges) {
-            int intersections = countIntersectionsForEdge(edge, allEdges);
-            edgeIntersections.insert(edge, intersections);
-        }
-
-        // Create a list of edges sorted by intersection count in descending order
-        QList<Edge*> sortedEdges = edgeIntersections.keys();
-        std::sort(sortedEdges.begin(), sortedEdges.end(), [&edgeIntersections](Edge* a, Edge* b) {
-            return edgeIntersections.value(a) > edgeIntersections.value(b);
-        });
-
-        // Iterate through the sorted edges and remove edges with intersections above the limit
-        for (Edge* edge : sortedEdges) {
-            if (edgeIntersections.value(edge) >= intersectionLimit) {
-                allEdges.removeOne(edge);
-                delete edge;
-                edgesRemoved = true;
-                break; // Restart the process after removing an edge
-            }
-        }
-    } while (edgesRemoved);
-}
-
-
-// Function to remove edges intersecting with nodes
-void Widget::removeNodeIntersectingEdges(QList<Node *> allNodes, QList<Edge *> &allEdges) {
-    // Define the threshold distance
-    qreal threshold = 40.0;
-
-    // List to store edges to remove
-    QList<Edge *> edgesToRemove;
-
-    // Iterate through each edge
-    for (Edge *edge : allEdges) {
-        // Get the line representing the edge
-        QLineF edgeLine(edge->getSourcePoint(), edge->getDestPoint());
-
-        // Iterate through each node
-        for (Node *node : allNodes) {
-            // Check if the edge's start or end node is the current node
-            if (node == edge->sourceNode() || node == edge->destNode()) {
-                continue; // Skip this node, as it's part of the edge
-            }
-
-            // Iterate along the edge to check for intersection with the node
-            for (qreal step = 0.0; step <= 1; step += 0.1) {
-                qreal dist = QLineF(node->pos(), edgeLine.pointAt(step)).length();
-                if (dist < threshold) {
-                    if (!edgesToRemove.contains(edge)) {
-                        edgesToRemove.append(edge);
-                    }
-                    break; // Move to the next edge
-                }
-            }
-        }
+// Function that swaps the individual edge items for the batched edge lines when zoomed out too far
+// for weights and arrows to be drawn, so thousands of edges cost one paint call
+void Widget::updateLevelOfDetail() {
+    if (!edgeBatch) {
+        return;
     }
-
-    // Remove edges intersecting with nodes
-    if (!edgesToRemove.isEmpty()) {
-        // Remove edges from allEdges and delete them
-        for (Edge *edge : std::as_const(edgesToRemove)) {
-            allEdges.removeOne(edge);
-            delete edge;
-        }
+    const bool batched = ui->graphicsView->transform().m11() < RenderStyle::DetailScale;
+    if (edgeBatch->isVisible() == batched) {
+        return; // Already in the right mode
+    }
+    edgeBatch->setVisible(batched);
+    for (Edge *edge : edgeItems) {
+        edge->setBatched(batched);
     }
 }
 
 
-// Dijkstra's algorithm to find the shortest path
-std::stack<Edge*> Widget::dijkstrasAlgorithm(Node* startNode, Node* endNode, const QList<Node*>& allNodes, const QList<Edge*>& allEdges) {
-    // Initialize distances map and predecessors map
-    std::map<Node*, int> distances;
-    std::map<Node*, Node*> predecessors;
-    for (Node* node : allNodes) {
-        distances[node] = std::numeric_limits<int>::max(); // Initialize all distances to infinity
-        predecessors[node] = nullptr; // Initialize all predecessors to nullptr
+// Function that handles the generation of the question components. The question says what it asks
+// for, so one prepared before a settings change or read from a bank is shown as it was generated.
+void Widget::generateQuestion(const Question &question) {
+    // Show the graph representation in the adjacency table; a distance question shows the distance
+    // matrix with the asked for distance hidden
+    printGraphRepresentation(question.graph, question.labelStyle);
+    if (question.kind == QuizMode::Distance) {
+        graphModel->setHiddenDistance(question.startNode, question.endNode);
+        ui->representationComboBox->setCurrentIndex(int(Representation::Distances));
+        ui->label_4->setText(QString("Use Dijkstra's algorithm to find the hidden distance from %1 to %2.")
+                                 .arg(QString::fromStdString(nodeLabel(question.startNode, question.labelStyle)))
+                                 .arg(QString::fromStdString(nodeLabel(question.endNode, question.labelStyle))));
+    } else if (!question.destinations.empty()) {
+        graphModel->setHiddenDistance(-1, -1);
+        ui->label_4->setText(QString("Use Dijkstra's algorithm to find the shortest path from %1 to %2. "
+                                     "The next questions ask about other nodes of this graph.")
+                                 .arg(QString::fromStdString(nodeLabel(question.startNode, question.labelStyle)))
+                                 .arg(QString::fromStdString(nodeLabel(question.endNode, question.labelStyle))));
+    } else {
+        graphModel->setHiddenDistance(-1, -1);
+        ui->label_4->setText("Use Dijkstra's algorithm to find the shortest path between the start and end nodes in this graph.");
     }
 
-    // Set distance of the start node to 0
-    distances[startNode] = 0;
-
-    // Create a priority queue to store nodes based on their distances
-    std::priority_queue<std::pair<int, Node*>, std::vector<std::pair<int, Node*>>, std::greater<std::pair<int, Node*>>> pq;
-
-    // Push the start node into the priority queue
-    pq.push({0, startNode});
+    // Keep the shortest path tree, which leads along the answer; a question read from a bank carries
+    // none, so one is grown from the graph and rerouted along the stored path
+    pathTree = question.tree;
+    if (pathTree.predecessorEdge.empty()) {
+        pathTree = dijkstra(question.graph, question.startNode);
+        followPath(question.graph, pathTree, question.startNode, question.path.edges);
+    }
+    pathStartNode = question.startNode;
+    pathEndNode = question.endNode;
+    labelStyle = question.labelStyle;
+    destinations = question.destinations;
+    nextDestination = 0;
+    showChoices(question.answer, question.optimalAnswers, question.choices, question.answerChoice);
+
+    // Show the seed, so the same question can be brought back later
+    ui->seedLineEdit->setText(QString::number(question.seed));
+}
 
-    // Main Dijkstra's algorithm loop
-    while (!pq.empty()) {
-        // Get the node with the minimum distance from the priority queue
-        Node* currNode = pq.top().second;
-        int currDist = pq.top().first;
-        pq.pop();
 
-        // Check if the current node has already been visited
-        if (currDist > distances[currNode]) {
-            continue; // Skip if already visited
-        }
+// Function that asks about another node of the graph on screen. Its answer was read off the same
+// shortest path tree, so nothing is generated or solved again and the highlight walks that tree.
+void Widget::presentDestination(const Destination &destination) {
+    clearChoices();
+    ui->submitButton->setDisabled(false); // Enable the submit button
+    ui->nextGraphButton->setDisabled(true); // Disable the next graph button until the question is answered
 
-        // Visit all neighbors of the current node
-        for (Edge* edge : allEdges) {
-            if (edge->sourceNode() == currNode || (!edge->isDirected() && edge->destNode() == currNode)) {
-                Node* neighbor = (edge->sourceNode() == currNode) ? edge->destNode() : edge->sourceNode();
-                int edgeWeight = edge->getWeight();
-                int newDist = currDist + edgeWeight;
-
-                // Update distance if a shorter path is found
-                if (newDist < distances[neighbor]) {
-                    distances[neighbor] = newDist;
-                    predecessors[neighbor] = currNode; // Update predecessor
-                    pq.push({newDist, neighbor});
-                }
-            }
-        }
+    // Clear the last highlight and mark the node asked about
+    for (Edge *edge : edgeItems) {
+        edge->setEdgeColour(Qt::black);
     }
-
-    // Stack to store the shortest path
-    std::stack<Edge*> shortestPath;
-
-    // Backtrack from the end node to the start node to find the shortest path
-    Node* currentNode = endNode;
-    Node* prevNode = nullptr;
-    while (currentNode != nullptr && predecessors[currentNode] != nullptr) {
-        // Find the edge between currentNode and its predecessor
-        for (Edge* edge : allEdges) {
-            if ((edge->sourceNode() == currentNode && edge->destNode() == predecessors[currentNode]) ||
-                (edge->sourceNode() == predecessors[currentNode] && edge->destNode() == currentNode)) {
-                shortestPath.push(edge);
-                break;
-            }
-        }
-        prevNode = currentNode;
-        currentNode = predecessors[currentNode];
+    for (Node *node : nodeItems) {
+        node->setNodeColour(RenderStyle::nodeColour());
     }
-
-    return shortestPath;
+    nodeItems[pathStartNode]->setNodeColour(RenderStyle::endpointColour());
+    nodeItems[destination.endNode]->setNodeColour(RenderStyle::endpointColour());
+    pathEndNode = destination.endNode;
+
+    // Ask for the distance with its entry hidden in the distance matrix, or for the path
+    const QString from = QString::fromStdString(nodeLabel(pathStartNode, labelStyle));
+    const QString to = QString::fromStdString(nodeLabel(destination.endNode, labelStyle));
+    if (destination.kind == QuizMode::Distance) {
+        graphModel->setHiddenDistance(pathStartNode, destination.endNode);
+        ui->representationComboBox->setCurrentIndex(int(Representation::Distances));
+        ui->label_4->setText(QString("Now find the hidden distance from %1 to %2 in the same graph.").arg(from).arg(to));
+    } else {
+        graphModel->setHiddenDistance(-1, -1);
+        showAdjacency(graphModel->rowCount());
+        ui->label_4->setText(QString("Now find the shortest path from %1 to %2 in the same graph.").arg(from).arg(to));
+    }
+    showChoices(destination.answer, destination.optimalAnswers, destination.choices, destination.answerChoice);
 }
 
 
-// Function that handles the generation of the question components
-void Widget::generateQuestion(std::stack<Edge *> shortestPath, const QList<Node *> allNodes, const QList<Edge *> &allEdges) {
-    // Print the graph representation in the text browser
-    printGraphRepresentation(allNodes, allEdges);
-
+// Function that stores the accepted answers and adds the answer options to the layout
+void Widget::showChoices(const std::string &answer, const std::vector<std::string> &optimalAnswers,
+                         const std::vector<std::string> &choices, int answerChoice) {
     // Construct the correct answer
-    QString rightAnswer = "A";
-    char prevNode = 'A';
-    while (!shortestPath.empty()) {
-        char nextNode = shortestPath.top()->destNode()->getName() != prevNode ?
-                            shortestPath.top()->destNode()->getName() : shortestPath.top()->sourceNode()->getName();
-        rightAnswer.append(nextNode);
-        shortestPath.pop();
-        prevNode = nextNode;
-    }
+    QString rightAnswer = QString::fromStdString(answer);
     correctAnswer = rightAnswer;
+    acceptedAnswers = QStringList{rightAnswer};
+    for (const std::string &tied : optimalAnswers) {
+        if (!acceptedAnswers.contains(QString::fromStdString(tied))) {
+            acceptedAnswers.append(QString::fromStdString(tied));
+        }
+    }
 
-    // Find alternative paths and shuffle them
-    QList<QString> alternativePaths = findAllPaths(rightAnswer, allNodes.first(), allNodes.last(), allEdges);
-    std::random_device rd;
-    std::mt19937 rng(rd());
-    std::shuffle(alternativePaths.begin(), alternativePaths.end(), rng);
-
-    // Determine the number of choices
-    int numberOfChoices = alternativePaths.size() <= 3 ? alternativePaths.size() + 1 : 5;
-    int answerButtonIndex = QRandomGenerator::global()->bounded(0, numberOfChoices - 1);
-    bool answerButtonCreated = false;
-
-    // Add answer options to the layout
-    for (int i = 0; i < numberOfChoices - 1; i+=0) {
-        if (i == answerButtonIndex && !answerButtonCreated) {
-            QRadioButton *radioButton = new QRadioButton(rightAnswer, this);
-            radioButton->setFont(QFont("Didot", 15));
-            ui->verticalLayout->addWidget(radioButton);
+    // Add the answer options to the layout, in the order the question's seed shuffled them into
+    for (int i = 0; i < int(choices.size()); i++) {
+        QRadioButton *radioButton = new QRadioButton(QString::fromStdString(choices[i]), this);
+        radioButton->setFont(QFont("Didot", 15));
+        ui->verticalLayout->addWidget(radioButton);
+        if (i == answerChoice) {
             // Connect the correct answer button
             connect(radioButton, &QRadioButton::clicked, this, [=]() {
                 correctAnswer = rightAnswer;
             });
-            answerButtonCreated = true;
-        } else {
-            QRadioButton *radioButton = new QRadioButton(alternativePaths[i], this);
-            radioButton->setFont(QFont("Didot", 15));
-            ui->verticalLayout->addWidget(radioButton);
-            i++;
         }
     }
 }
 
 
-// Function that generates the adjacency matrix representation of the graph
-void Widget::printGraphRepresentation(const QList<Node*>& allNodes, const QList<Edge*>& allEdges) {
-    int numNodes = allNodes.size();
-    QVector<QVector<int>> adjacencyMatrix(numNodes, QVector<int>(numNodes, 0));
-
-    // Fill the adjacency matrix with edge weights
-    for (Edge* edge : allEdges) {
-        int sourceIndex = allNodes.indexOf(edge->sourceNode());
-        int destIndex = allNodes.indexOf(edge->destNode());
-        adjacencyMatrix[sourceIndex][destIndex] = edge->getWeight();
-        if (!edge->isDirected()) {
-            adjacencyMatrix[destIndex][sourceIndex] = edge->getWeight();
-        }
-    }
-
-    // Create the HTML table for the adjacency matrix
-    QString graphRepresentation = "<html><head><style>"
-                                  "table { border-collapse: collapse; }"
-                                  "th, td { border: 1px solid black; padding: 5px; text-align: center; }"
-                                  "th { background-color: #f2f2f2; }"
-                                  ".red-text { color: red; }"
-                                  "</style></head><body>";
-
-    // Add introductory text
-    graphRepresentation += "<p>The adjacency matrix for the graph G = (V, E) is shown below:</p>";
-
-    // Add table headers
-    graphRepresentation += "<table><tr><th></th>";
-    for (Node* node : allNodes) {
-        graphRepresentation += "<th>" + QString(node->getName()) + "</th>";
-    }
-    graphRepresentation += "</tr>";
-
-    // Add table rows
-    for (int i = 0; i < numNodes; ++i) {
-        graphRepresentation += "<tr><th>" + QString(allNodes[i]->getName()) + "</th>";
-        for (int j = 0; j < numNodes; ++j) {
-            if (adjacencyMatrix[i][j] != 0) {
-                graphRepresentation += "<td class='red-text'>" + QString::number(adjacencyMatrix[i][j]) + "</td>";
-            } else {
-                graphRepresentation += "<td>" + QString::number(adjacencyMatrix[i][j]) + "</td>";
-            }
-        }
-        graphRepresentation += "</tr>";
-    }
-
-    graphRepresentation += "</table></body></html>";
-
-    // Display the adjacency matrix in the QTextBrowser
-    ui->textBrowser->setHtml(graphRepresentation);
+// Function that shows the graph in the adjacency table. The table leaves the distance matrix first, so a
+// path question never opens on the distances; a distance question switches back to them afterwards.
+void Widget::printGraphRepresentation(const Graph& graph, LabelStyle labelStyle) {
+    showAdjacency(graph.nodeCount());
+    graphModel->setGraph(graph, labelStyle);
 }
 
 
-// Function that finds all the alternate paths for distractors using DFS
-QList<QString> Widget::findAllPaths(const QString& shortestPath, Node* startNode, Node* endNode, const QList<Edge*>& allEdges) {
-    // Perform DFS to find all paths from startNode to endNode
-    QList<QList<Node*>> allPaths = dfs(startNode, endNode, allEdges);
-
-    // Convert paths to QStrings and filter out paths based on length
-    QList<QString> alternatePaths;
-    int shortestPathLength = shortestPath.length();
-
-    for (const auto& path : allPaths) {
-        // Check if the path length matches the criteria
-        int pathLength = path.size();
-        if (pathLength == shortestPathLength || pathLength == shortestPathLength - 1 || pathLength == shortestPathLength + 1) {
-            QString pathString;
-            for (Node* node : path) {
-                pathString += node->getName();
-            }
-            alternatePaths.append(pathString);
-        }
+// Function that switches the table from the distance matrix back to the graph itself, which would
+// otherwise answer a path question. A large graph goes to the adjacency list, where each row fits the
+// view; the matrix stays available from the representation combo box.
+void Widget::showAdjacency(int nodeCount) {
+    if (nodeCount > SingleLetterLabels) {
+        ui->representationComboBox->setCurrentIndex(int(Representation::List));
+    } else if (graphModel->representation() == Representation::Distances) {
+        ui->representationComboBox->setCurrentIndex(int(Representation::Matrix));
     }
-
-    // Remove the shortest path from the list of alternative paths
-    alternatePaths.removeAll(shortestPath);
-
-    return alternatePaths;
 }
 
 
-// DFS algorithm to find all paths between start and end node
-QList<QList<Node*>> Widget::dfs(Node* startNode, Node* endNode, const QList<Edge*>& allEdges) {
-    QList<QList<Node*>> allPaths;
-    QList<Node*> currentPath;
-    QSet<Node*> visited;
-
-    // Helper lambda function for DFS recursion
-    std::function<void(Node*)> dfsRecursive = [&](Node* currentNode) {
-        // Mark the current node as visited
-        visited.insert(currentNode);
-
-        // Add current node to the current path
-        currentPath.append(currentNode);
-
-        // If the current node is the end node, add the current path to allPaths
-        if (currentNode == endNode) {
-            allPaths.append(currentPath);
-        } else {
-            // Continue DFS to its neighbors
-            for (Edge* edge : allEdges) {
-                if (edge->sourceNode() == currentNode || (!edge->isDirected() && edge->destNode() == currentNode)) {
-                    Node* neighbor = (edge->sourceNode() == currentNode) ? edge->destNode() : edge->sourceNode();
-                    if (!visited.contains(neighbor)) {
-                        dfsRecursive(neighbor);
-                    }
-                }
-            }
-        }
-
-        // Backtrack: remove the current node from the current path and mark it as unvisited
-        currentPath.removeLast();
-        visited.remove(currentNode);
-    };
-
-    // Start DFS from the start node
-    dfsRecursive(startNode);
-
-    return allPaths;
-}
-
-
-// Function that counts all the intersections that a given edge has
-int Widget::countIntersectionsForEdge(const Edge* edgeToCheck, const QList<Edge*>& allEdges) {
-    int intersectionCount = 0;
-
-    // Check the provided edge against all other edges
-    for (Edge* otherEdge : allEdges) {
-        if (edgeToCheck != otherEdge) {
-            // Check for intersection with the provided edge
-            if (edgeToCheck->intersects(*otherEdge)) {
-                intersectionCount++;
-            }
-        }
-    }
-    // Return the intersection count for the provided edge
-    return intersectionCount;
-}
-
-
-// Function that iterates through edges and ndes part of the shortest path and changes their colour to highlight
+// Function that walks the shortest path tree back from the end node and changes the colour of the edges
+// and nodes along the way, one step per edge
 void Widget::highlightShortestPath(QColor colour) {
-    // Create a set to store visited nodes
-    QSet<Node*> visitedNodes;
-
-    // Iterate through the shortest path and highlight edges and nodes
-    std::stack<Edge*> path = shortestPath;
-    while (!path.empty()) {
-        Edge* edge = path.top();
-        path.pop();
-
-        // Highlight edge
-        edge->setEdgeColour(colour);
-
-        // Highlight source and destination nodes
-        visitedNodes.insert(edge->sourceNode());
-        visitedNodes.insert(edge->destNode());
+    if (pathEndNode == -1) {
+        return;
     }
 
-    // Highlight nodes that are part of the shortest path
-    for (Node* node : visitedNodes) {
-        node->setNodeColour(colour);
+    // Highlight the edges and their source and destination nodes
+    for (int id : pathEdges(pathTree, pathEndNode)) {
+        Edge *edge = edgeItems[id];
+        edge->setEdgeColour(colour);
+        edge->sourceNode()->setNodeColour(colour);
+        edge->destNode()->setNodeColour(colour);
     }
 }
 
@@ -706,8 +486,10 @@ void Widget::wheelEvent(QWheelEvent *event) {
     // Get the angle delta
     int angle = event->angleDelta().y();
 
-    // Define minimum and maximum scale factors
-    qreal minScale = 0.5;
+    // Define minimum and maximum scale factors, letting large scenes zoom out until they fit the view
+    QRectF sceneRect = ui->graphicsView->sceneRect();
+    QSize viewSize = ui->graphicsView->viewport()->size();
+    qreal minScale = qMin(0.5, qMin(viewSize.width() / sceneRect.width(), viewSize.height() / sceneRect.height()));
     qreal maxScale = 2.0;
 
     // Calculate the scaling factor
@@ -735,6 +517,9 @@ void Widget::wheelEvent(QWheelEvent *event) {
     // Adjust the view to keep the cursor fixed
     ui->graphicsView->translate(newPos.x() - oldPos.x(), newPos.y() - oldPos.y());
 
+    // Switch between individual and batched edges for the new zoom
+    updateLevelOfDetail();
+
     event->accept();
 }
 
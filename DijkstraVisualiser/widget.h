@@ -2,8 +2,14 @@
 #define WIDGET_H
 
 #include "edge.h"
+#include "edgebatchitem.h"
+#include "graph.h"
+#include "graphregionitem.h"
+#include "graphtablemodel.h"
+#include "question.h"
+#include "questionbankfile.h"
+#include "questionprefetcher.h"
 #include <QWidget>
-#include <stack>
 
 QT_BEGIN_NAMESPACE
 namespace Ui {
@@ -19,30 +25,50 @@ public:
     Widget(QWidget *parent = nullptr);
     ~Widget();
 
+    bool openQuestionBank(const QString &fileName); // Serves questions from a pre-generated bank instead of generating them
+    bool openGraph(const QString &fileName, QString *error = nullptr); // Shows a graph imported from a file until the next question
+
 private:
     Ui::Widget *ui; // Pointer to the UI object
     const int sceneWidth = 771; // Scene width constant
     const int sceneHeight = 600; // Scene height constant
-    std::map<int, char> labels; // Map for labels
-    std::stack<Edge*> shortestPath; // Stack for shortest path
+    const int largeSceneWidth = 4000; // Scene width for large graphs, viewed by scrolling and zooming
+    const int largeSceneHeight = 2400; // Scene height for large graphs
+    SearchResult pathTree; // Shortest path tree of the question on screen, leading along the answer
+    int pathStartNode = -1; // Node the answer starts at, -1 when no question is shown
+    int pathEndNode = -1; // Node the answer ends at, -1 when no question is shown
+    LabelStyle labelStyle = LabelStyle::Letters; // How the nodes of the question on screen are labelled
+    std::vector<Destination> destinations; // Further questions on the graph on screen, asked in order
+    int nextDestination = 0; // Index of the next of those questions
+    QList<Node*> nodeItems; // Node items of the current scene, owned by the scene
+    QList<Edge*> edgeItems; // Edge items of the current scene, owned by the scene
+    EdgeBatchItem *edgeBatch = nullptr; // Batched edge lines for large scenes, null for small ones, owned by the scene
+    GraphRegionItem *importedGraph = nullptr; // Imported graph on screen, null while a question is shown, owned by the scene
     QString correctAnswer; // Correct answer string
+    QStringList acceptedAnswers; // Every answer marked correct, including paths tied with the shortest one
     int questionsAttempted = 0; // Number of questions attempted
     int questionsCorrect = 0; // Number of questions answered correctly
+    QuestionPrefetcher *prefetcher; // Prepares upcoming questions in the background
+    GraphTableModel *graphModel; // Adjacency matrix or list of the current graph, shown in the table view
+    QuestionBankFile questionBank; // Pre-generated questions, used instead of the generator while open
+    int nextBankQuestion = 0; // Index of the next question taken from the bank
 
     // Private functions
     void resetScreen();
+    void clearChoices();
+    void showNextGraph();
     void generateGraph(int graphType);
-    QList<Node *> generateNodes(int graphType, const int numOfColumns);
-    QList<Edge *> generateEdges(QList<Node *> allNodes, const int graphType);
-    void removeEdgesWithHighIntersections(QList<Edge*>& allEdges, int intersectionLimit);
-    int countIntersectionsForEdge(const Edge* edgeToCheck, const QList<Edge*>& allEdges);
-    void removeNodeIntersectingEdges(QList<Node *> allNodes, QList<Edge *> &allEdges);
-    std::stack<Edge *> dijkstrasAlgorithm(Node* startNode, Node* endNode, const QList<Node*>& allNodes, const QList<Edge*>& allEdges);
-    void generateQuestion(std::stack<Edge *> shortestPath, const QList<Node *> allNodes, const QList<Edge *> &allEdges);
-    QList<QString> findAllPaths(const QString& shortestPath, Node* startNode, Node* endNode, const QList<Edge*>& allEdges);
-    QList<QList<Node*>> dfs(Node* startNode, Node* endNode, const QList<Edge*>& allEdges);
-    void printGraphRepresentation(const QList<Node*>& allNodes, const QList<Edge*>& allEdges);
+    GeneratorConfig generatorConfig(int graphType);
+    SolverMode solverMode();
+    void presentQuestion(const Question &question);
+    void generateQuestion(const Question &question);
+    void presentDestination(const Destination &destination);
+    void showChoices(const std::string &answer, const std::vector<std::string> &optimalAnswers,
+                     const std::vector<std::string> &choices, int answerChoice);
+    void printGraphRepresentation(const Graph& graph, LabelStyle labelStyle);
+    void showAdjacency(int nodeCount);
     void highlightShortestPath(QColor colour);
+    void updateLevelOfDetail();
 
 private slots:
     // Private slots
@@ -50,5 +76,6 @@ private slots:
     void on_submitButton_clicked();
     void wheelEvent(QWheelEvent *event);
     void on_helpButton_clicked();
+    void on_seedLineEdit_returnPressed();
 };
 #endif // WIDGET_H
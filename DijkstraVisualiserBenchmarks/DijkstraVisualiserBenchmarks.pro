@@ -0,0 +1,37 @@
+QT = core gui
+
+# Define the target
+TARGET = DijkstraVisualiserBenchmarks
+TEMPLATE = app
+
+# Headless console application; besides the graph core it only needs the table model, which runs
+# without a display
+CONFIG += console c++17
+CONFIG -= app_bundle
+
+# Results are written to the build directory unless --benchmark_out says otherwise
+DEFINES += BENCHMARK_OUTPUT_DIR=\\\"$$OUT_PWD\\\"
+
+# Include the necessary directories
+INCLUDEPATH += ../DijkstraVisualiser
+DEPENDPATH += ../DijkstraVisualiser
+
+# Add the source and header files
+SOURCES += main.cpp \
+           bench_dijkstra.cpp \
+           bench_pipeline.cpp \
+           bench_allpairs.cpp \
+           ../DijkstraVisualiser/graphtablemodel.cpp
+
+HEADERS += ../DijkstraVisualiser/graphtablemodel.h
+
+# Headless graph core
+include(../GraphCore/GraphCore.pri)
+
+# Google Benchmark, from a build next to the project if there is one, otherwise the system install
+exists($$PWD/../benchmark/build/src) {
+    INCLUDEPATH += $$PWD/../benchmark/include
+    LIBS += -L$$PWD/../benchmark/build/src
+}
+LIBS += -lbenchmark
+unix: LIBS += -lpthread
@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include "allpairs.h"
+
+namespace {
+
+// Builds a seeded random undirected graph with about the given number of arcs per node
+Graph randomGraph(int numNodes, int arcsPerNode, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> node(0, numNodes - 1);
+    std::uniform_int_distribution<int> weight(1, MaxGeneratedWeight);
+
+    std::vector<Point> positions(numNodes);
+    std::vector<GraphEdge> edges;
+    for (int i = 0; i < numNodes * arcsPerNode / 2; i++) {
+        int a = node(rng);
+        int b = node(rng);
+        if (a != b) {
+            edges.push_back({a, b, weight(rng), false});
+        }
+    }
+    return Graph(positions, edges);
+}
+
+// Node counts crossed with arcs per node, from road-like sparse graphs to nearly complete ones
+void allPairsSweep(benchmark::internal::Benchmark *benchmark) {
+    for (int nodes : {32, 128, 512, 1024}) {
+        for (int arcsPerNode : {4, 16, 64, 256}) {
+            if (arcsPerNode < nodes) {
+                benchmark->Args({nodes, arcsPerNode});
+            }
+        }
+    }
+}
+
+} // namespace
+
+static void BM_FloydWarshall(benchmark::State &state) {
+    Graph graph = randomGraph(int(state.range(0)), int(state.range(1)), 42);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(floydWarshall(graph).distances.data());
+    }
+}
+BENCHMARK(BM_FloydWarshall)->Apply(allPairsSweep)->Unit(benchmark::kMicrosecond);
+
+static void BM_RepeatedDijkstra(benchmark::State &state) {
+    Graph graph = randomGraph(int(state.range(0)), int(state.range(1)), 42);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(repeatedDijkstra(graph).distances.data());
+    }
+}
+BENCHMARK(BM_RepeatedDijkstra)->Apply(allPairsSweep)->Unit(benchmark::kMicrosecond);
+
+static void BM_RepeatedDijkstraPool(benchmark::State &state) {
+    Graph graph = randomGraph(int(state.range(0)), int(state.range(1)), 42);
+    WorkStealingPool pool;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(repeatedDijkstra(graph, &pool).distances.data());
+    }
+    state.counters["threads"] = pool.threadCount();
+}
+BENCHMARK(BM_RepeatedDijkstraPool)->Apply(allPairsSweep)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+// The strategy allPairs picks, which should track the faster of the single threaded two
+static void BM_AllPairs(benchmark::State &state) {
+    Graph graph = randomGraph(int(state.range(0)), int(state.range(1)), 42);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(allPairs(graph).distances.data());
+    }
+}
+BENCHMARK(BM_AllPairs)->Apply(allPairsSweep)->Unit(benchmark::kMicrosecond);
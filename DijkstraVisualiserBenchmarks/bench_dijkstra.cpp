@@ -0,0 +1,159 @@
+#include <benchmark/benchmark.h>
+#include <functional>
+#include <map>
+#include <queue>
+#include <random>
+#include "deltastepping.h"
+#include "shortestpath.h"
+
+namespace {
+
+// Builds a seeded random connected graph with roughly three edges per node and generator-sized weights
+Graph randomGraph(int numNodes, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> node(0, numNodes - 1);
+    std::uniform_int_distribution<int> weight(1, MaxGeneratedWeight);
+    std::bernoulli_distribution directed(0.3);
+
+    std::vector<Point> positions(numNodes);
+    std::vector<GraphEdge> edges;
+    for (int i = 0; i + 1 < numNodes; i++) {
+        edges.push_back({i, i + 1, weight(rng), false});
+    }
+    for (int i = 0; i < 2 * numNodes; i++) {
+        int a = node(rng);
+        int b = node(rng);
+        if (a != b) {
+            edges.push_back({a, b, weight(rng), directed(rng)});
+        }
+    }
+    return Graph(positions, edges);
+}
+
+// Scene-item stand-ins for the pointer-keyed implementation the widget used before the graph core
+struct LegacyNode {};
+struct LegacyEdge {
+    LegacyNode *source;
+    LegacyNode *dest;
+    int weight;
+    bool directed;
+};
+
+// The original Widget::dijkstrasAlgorithm: pointer-keyed std::map state and a full edge list scan per settled node
+int legacyDijkstra(LegacyNode *startNode, LegacyNode *endNode, const std::vector<LegacyNode *> &allNodes, const std::vector<LegacyEdge> &allEdges) {
+    std::map<LegacyNode *, int> distances;
+    std::map<LegacyNode *, LegacyNode *> predecessors;
+    for (LegacyNode *node : allNodes) {
+        distances[node] = std::numeric_limits<int>::max();
+        predecessors[node] = nullptr;
+    }
+    distances[startNode] = 0;
+
+    std::priority_queue<std::pair<int, LegacyNode *>, std::vector<std::pair<int, LegacyNode *>>, std::greater<std::pair<int, LegacyNode *>>> pq;
+    pq.push({0, startNode});
+    while (!pq.empty()) {
+        LegacyNode *currNode = pq.top().second;
+        int currDist = pq.top().first;
+        pq.pop();
+        if (currDist > distances[currNode]) {
+            continue;
+        }
+        for (const LegacyEdge &edge : allEdges) {
+            if (edge.source == currNode || (!edge.directed && edge.dest == currNode)) {
+                LegacyNode *neighbor = edge.source == currNode ? edge.dest : edge.source;
+                int newDist = currDist + edge.weight;
+                if (newDist < distances[neighbor]) {
+                    distances[neighbor] = newDist;
+                    predecessors[neighbor] = currNode;
+                    pq.push({newDist, neighbor});
+                }
+            }
+        }
+    }
+    return distances[endNode];
+}
+
+// Binary heap Dijkstra over the CSR adjacency, isolating the queue from the data layout
+int binaryHeapDijkstra(const Graph &graph, int startNode, int endNode, std::vector<int> &distance) {
+    distance.assign(graph.nodeCount(), Unreachable);
+    distance[startNode] = 0;
+    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<std::pair<int, int>>> pq;
+    pq.push({0, startNode});
+    while (!pq.empty()) {
+        auto [currDist, currNode] = pq.top();
+        pq.pop();
+        if (currDist > distance[currNode]) {
+            continue;
+        }
+        for (const Arc &arc : graph.outArcs(currNode)) {
+            if (currDist + arc.weight < distance[arc.node]) {
+                distance[arc.node] = currDist + arc.weight;
+                pq.push({distance[arc.node], arc.node});
+            }
+        }
+    }
+    return distance[endNode];
+}
+
+} // namespace
+
+static void BM_LegacyDijkstra(benchmark::State &state) {
+    Graph graph = randomGraph(int(state.range(0)), 42);
+    std::vector<LegacyNode> nodeStorage(graph.nodeCount());
+    std::vector<LegacyNode *> allNodes;
+    for (LegacyNode &node : nodeStorage) {
+        allNodes.push_back(&node);
+    }
+    std::vector<LegacyEdge> allEdges;
+    for (const GraphEdge &e : graph.edges()) {
+        allEdges.push_back({allNodes[e.source], allNodes[e.dest], e.weight, e.directed});
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(legacyDijkstra(allNodes.front(), allNodes.back(), allNodes, allEdges));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_LegacyDijkstra)->RangeMultiplier(4)->Range(32, 2048)->Complexity();
+
+static void BM_BinaryHeapDijkstra(benchmark::State &state) {
+    Graph graph = randomGraph(int(state.range(0)), 42);
+    std::vector<int> distance;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(binaryHeapDijkstra(graph, 0, graph.nodeCount() - 1, distance));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_BinaryHeapDijkstra)->RangeMultiplier(8)->Range(32, 1 << 18)->Complexity();
+
+static void BM_DialDijkstra(benchmark::State &state) {
+    Graph graph = randomGraph(int(state.range(0)), 42);
+    DijkstraEngine<MaxGeneratedWeight> engine;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine.run(graph, 0).distance.back());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_DialDijkstra)->RangeMultiplier(8)->Range(32, 1 << 18)->Complexity();
+
+static void BM_RadixHeapDijkstra(benchmark::State &state) {
+    Graph graph = randomGraph(int(state.range(0)), 42);
+    DijkstraEngine<> engine;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine.run(graph, 0).distance.back());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_RadixHeapDijkstra)->RangeMultiplier(8)->Range(32, 1 << 18)->Complexity();
+
+// Delta-stepping across the bucket widths, sequentially and on a pool, at 1 << 18 nodes; width 0 is
+// the per-graph default
+static void BM_DeltaStepping(benchmark::State &state) {
+    Graph graph = randomGraph(1 << 18, 42);
+    WorkStealingPool pool;
+    DeltaStepping search(state.range(1) ? &pool : nullptr, int(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(search.run(graph, 0).distance.back());
+    }
+    state.counters["threads"] = state.range(1) ? pool.threadCount() : 1;
+}
+BENCHMARK(BM_DeltaStepping)->ArgsProduct({{0, 1, 2, 4, 8, 16}, {0, 1}})->Unit(benchmark::kMillisecond)->UseRealTime();
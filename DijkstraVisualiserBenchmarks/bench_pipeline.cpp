@@ -0,0 +1,205 @@
+#include <benchmark/benchmark.h>
+#include "graphgenerator.h"
+#include "graphtablemodel.h"
+#include "question.h"
+
+namespace {
+
+constexpr uint64_t Seed = 42; // Every benchmark generates its inputs from the same seed
+constexpr double ColumnSpacing = 100; // Scene width per column, so wider sweeps keep the node density
+
+// Generation options for a sweep point: range(0) columns of graph type range(1). The graph type sets
+// how many nodes share a column, so it sweeps the density while the column count sweeps the size.
+GeneratorConfig sweepConfig(const benchmark::State &state) {
+    GeneratorConfig config;
+    config.graphType = int(state.range(1));
+    config.sceneWidth = ColumnSpacing * (state.range(0) + 1) + 20;
+    return config;
+}
+
+// Layout of a sweep point after the stages up to and including the given one
+enum class Stage { Nodes, Edges, Intersections, Clearance };
+GraphLayout sweepLayout(const benchmark::State &state, Stage last) {
+    GeneratorConfig config = sweepConfig(state);
+    Random random(Seed);
+    GraphGenerator generator(config, random);
+    GraphLayout layout = generator.generateNodes(int(state.range(0)));
+    if (last >= Stage::Edges) {
+        generator.generateEdges(layout);
+    }
+    if (last >= Stage::Intersections) {
+        generator.removeEdgesWithHighIntersections(layout);
+    }
+    if (last >= Stage::Clearance) {
+        generator.removeNodeIntersectingEdges(layout);
+    }
+    return layout;
+}
+
+// Highest node id reachable from node 0, so queries on disconnected pruned graphs still have a path
+int farthestReachable(const Graph &graph) {
+    SearchResult result = dijkstra(graph, 0);
+    int node = graph.nodeCount() - 1;
+    while (node > 0 && result.distance[node] == Unreachable) {
+        node--;
+    }
+    return node;
+}
+
+// Reports the size of the graph a stage worked on
+void setGraphCounters(benchmark::State &state, const GraphLayout &layout) {
+    state.counters["nodes"] = double(layout.positions.size());
+    state.counters["edges"] = double(layout.edges.size());
+}
+
+// Column counts and graph types swept by the generation stages
+void generationSweep(benchmark::internal::Benchmark *b) {
+    b->ArgNames({"columns", "type"})->ArgsProduct({{4, 16, 64, 256}, {0, 1, 2}})->Unit(benchmark::kMicrosecond);
+}
+
+} // namespace
+
+// Each stage copies the output of the stage before it inside the timed loop, as stages modify the
+// layout in place; the copy is small next to the stage itself
+
+static void BM_GenerateNodes(benchmark::State &state) {
+    GeneratorConfig config = sweepConfig(state);
+    GraphLayout layout;
+    for (auto _ : state) {
+        Random random(Seed);
+        GraphGenerator generator(config, random);
+        layout = generator.generateNodes(int(state.range(0)));
+        benchmark::DoNotOptimize(layout.positions.data());
+    }
+    setGraphCounters(state, layout);
+}
+BENCHMARK(BM_GenerateNodes)->Apply(generationSweep);
+
+static void BM_GenerateEdges(benchmark::State &state) {
+    GeneratorConfig config = sweepConfig(state);
+    const GraphLayout nodes = sweepLayout(state, Stage::Nodes);
+    GraphLayout layout;
+    for (auto _ : state) {
+        Random random(Seed);
+        GraphGenerator generator(config, random);
+        layout = nodes;
+        generator.generateEdges(layout);
+        benchmark::DoNotOptimize(layout.edges.data());
+    }
+    setGraphCounters(state, layout);
+}
+BENCHMARK(BM_GenerateEdges)->Apply(generationSweep);
+
+static void BM_RemoveEdgesWithHighIntersections(benchmark::State &state) {
+    GeneratorConfig config = sweepConfig(state);
+    const GraphLayout edges = sweepLayout(state, Stage::Edges);
+    Random random(Seed);
+    GraphGenerator generator(config, random);
+    GraphLayout layout;
+    for (auto _ : state) {
+        layout = edges;
+        generator.removeEdgesWithHighIntersections(layout);
+        benchmark::DoNotOptimize(layout.edges.data());
+    }
+    setGraphCounters(state, edges);
+}
+BENCHMARK(BM_RemoveEdgesWithHighIntersections)->Apply(generationSweep);
+
+static void BM_RemoveNodeIntersectingEdges(benchmark::State &state) {
+    GeneratorConfig config = sweepConfig(state);
+    const GraphLayout pruned = sweepLayout(state, Stage::Intersections);
+    Random random(Seed);
+    GraphGenerator generator(config, random);
+    GraphLayout layout;
+    for (auto _ : state) {
+        layout = pruned;
+        generator.removeNodeIntersectingEdges(layout);
+        benchmark::DoNotOptimize(layout.edges.data());
+    }
+    setGraphCounters(state, pruned);
+}
+BENCHMARK(BM_RemoveNodeIntersectingEdges)->Apply(generationSweep);
+
+static void BM_Dijkstra(benchmark::State &state) {
+    const GraphLayout layout = sweepLayout(state, Stage::Clearance);
+    const Graph graph(layout.positions, layout.edges);
+    const int endNode = farthestReachable(graph);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(shortestPath(graph, 0, endNode, SolverMode::Dijkstra).distance);
+    }
+    setGraphCounters(state, layout);
+}
+BENCHMARK(BM_Dijkstra)->Apply(generationSweep);
+
+static void BM_NearOptimalPaths(benchmark::State &state) {
+    const GraphLayout layout = sweepLayout(state, Stage::Clearance);
+    const Graph graph(layout.positions, layout.edges);
+    const int endNode = farthestReachable(graph);
+    const PathResult answer = shortestPath(graph, 0, endNode, SolverMode::Dijkstra);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(nearOptimalPaths(graph, answer, 0, endNode, DistractorCount).size());
+    }
+    setGraphCounters(state, layout);
+}
+BENCHMARK(BM_NearOptimalPaths)->Apply(generationSweep);
+
+// The further destinations of a multi-destination round, with their distractors searched for afresh or
+// read off the shared tree as sidetracks, as the pipeline does. The large graph type is left out, as its
+// first node rarely reaches the others once the graph is pruned.
+static void BM_AskDestinations(benchmark::State &state) {
+    const GraphLayout layout = sweepLayout(state, Stage::Clearance);
+    const Graph graph(layout.positions, layout.edges);
+    const SearchResult tree = dijkstra(graph, 0);
+    const bool sidetracks = state.range(2) != 0;
+    std::vector<int> destinations;
+    for (int node = graph.nodeCount() - 1; node > 0 && int(destinations.size()) < DestinationsPerGraph - 1; node--) {
+        if (tree.distance[node] != Unreachable && pathEdges(tree, node).size() >= 2) {
+            destinations.push_back(node);
+        }
+    }
+    for (auto _ : state) {
+        Random random(Seed);
+        for (int i = 0; i < int(destinations.size()); i++) {
+            const QuizMode kind = i % 2 == 0 ? QuizMode::Distance : QuizMode::ShortestPath;
+            const PathResult path = pathTo(tree, destinations[i]);
+            if (sidetracks) {
+                const std::vector<PathResult> nearPaths = sidetrackPaths(graph, tree, destinations[i]);
+                benchmark::DoNotOptimize(askDestination(graph, tree, 0, destinations[i], path, kind,
+                                                        LabelStyle::Letters, random, &nearPaths));
+            } else {
+                benchmark::DoNotOptimize(askDestination(graph, tree, 0, destinations[i], path, kind,
+                                                        LabelStyle::Letters, random));
+            }
+        }
+    }
+    setGraphCounters(state, layout);
+    state.counters["destinations"] = double(destinations.size());
+}
+BENCHMARK(BM_AskDestinations)
+    ->ArgNames({"columns", "type", "sidetracks"})
+    ->ArgsProduct({{4, 16, 64, 256}, {0, 1}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+// Loading a graph into the table model and formatting the cells a table view shows at once
+static void BM_PrintGraphRepresentation(benchmark::State &state) {
+    const GraphLayout layout = sweepLayout(state, Stage::Clearance);
+    const Graph graph(layout.positions, layout.edges);
+    const Representation representation = static_cast<Representation>(state.range(2));
+    const int visibleRows = std::min(graph.nodeCount(), 12);
+    GraphTableModel model;
+    model.setRepresentation(representation);
+    for (auto _ : state) {
+        model.setGraph(graph, LabelStyle::Letters);
+        for (int row = 0; row < visibleRows; row++) {
+            benchmark::DoNotOptimize(model.headerData(row, Qt::Vertical));
+            for (int column = 0; column < std::min(model.columnCount(), 12); column++) {
+                benchmark::DoNotOptimize(model.data(model.index(row, column)));
+            }
+        }
+    }
+    setGraphCounters(state, layout);
+}
+BENCHMARK(BM_PrintGraphRepresentation)
+    ->ArgNames({"columns", "type", "list"})
+    ->ArgsProduct({{4, 16, 64, 256}, {0, 1, 2}, {int(Representation::Matrix), int(Representation::List)}})
+    ->Unit(benchmark::kMicrosecond);
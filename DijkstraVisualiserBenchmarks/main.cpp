@@ -0,0 +1,34 @@
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Build directory the project file passes in, so results never land in the source tree
+#ifndef BENCHMARK_OUTPUT_DIR
+#define BENCHMARK_OUTPUT_DIR "."
+#endif
+
+// Runs the benchmarks, also writing the results as JSON for tracking trends across runs. The file
+// defaults to DijkstraVisualiserBenchmarks.json in the build directory; --benchmark_out=<file> picks another one.
+int main(int argc, char *argv[]) {
+    std::vector<char *> args(argv, argv + argc);
+    bool hasOutput = false;
+    for (int i = 1; i < argc; i++) {
+        hasOutput = hasOutput || std::strncmp(argv[i], "--benchmark_out=", 16) == 0;
+    }
+    std::string defaultOutput = "--benchmark_out=" BENCHMARK_OUTPUT_DIR "/DijkstraVisualiserBenchmarks.json";
+    char jsonFormat[] = "--benchmark_out_format=json";
+    if (!hasOutput) {
+        args.push_back(defaultOutput.data());
+        args.push_back(jsonFormat);
+    }
+    int numArgs = int(args.size());
+
+    ::benchmark::Initialize(&numArgs, args.data());
+    if (::benchmark::ReportUnrecognizedArguments(numArgs, args.data())) {
+        return 1;
+    }
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+    return 0;
+}
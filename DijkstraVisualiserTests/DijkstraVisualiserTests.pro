@@ -5,21 +5,66 @@ TARGET = DijkstraVisualiserTest
 TEMPLATE = app
 
 # Include the necessary directories
-INCLUDEPATH += ../DijkstraVisualiser
-DEPENDPATH += ../DijkstraVisualiser
+INCLUDEPATH += ../DijkstraVisualiser ../GraphCore
+DEPENDPATH += ../DijkstraVisualiser ../GraphCore
+CONFIG += c++17
 
 # Add the source and header files
 SOURCES += test_edge.cpp \
            main.cpp \
            test_node.cpp \
-           test_widget.cpp
+           test_widget.cpp \
+           test_graph.cpp \
+           test_shortestpath.cpp \
+           test_graphgenerator.cpp \
+           test_question.cpp \
+           test_questionprefetcher.cpp \
+           test_crossinggraph.cpp \
+           test_spatialgrid.cpp \
+           test_segmentgrid.cpp \
+           test_kdtree.cpp \
+           test_nodelabel.cpp \
+           test_edgebatchitem.cpp \
+           test_kshortestpaths.cpp \
+           test_graphtablemodel.cpp \
+           test_questionbank.cpp \
+           test_questionbankfile.cpp \
+           test_graphimporter.cpp \
+           test_graphregionitem.cpp \
+           test_allpairs.cpp \
+           test_deltastepping.cpp
 
-# Link against the main project library
-LIBS += -L$$OUT_PWD/../build-DijkstraVisualiser-Desktop_arm_darwin_generic_mach_o_64bit-Release -lDijkstraVisualiser
+# Build the application's classes into the test binary, so the tests do not depend on a library
+# from a particular platform's build directory
+SOURCES += ../DijkstraVisualiser/widget.cpp \
+           ../DijkstraVisualiser/node.cpp \
+           ../DijkstraVisualiser/edge.cpp \
+           ../DijkstraVisualiser/questionprefetcher.cpp \
+           ../DijkstraVisualiser/renderstyle.cpp \
+           ../DijkstraVisualiser/edgebatchitem.cpp \
+           ../DijkstraVisualiser/graphtablemodel.cpp \
+           ../DijkstraVisualiser/questionbankfile.cpp \
+           ../DijkstraVisualiser/graphregionitem.cpp
 
-# Ensure the main project is built first
-PRE_TARGETDEPS += ../build-DijkstraVisualiser-Desktop_arm_darwin_generic_mach_o_64bit-Release/libDijkstraVisualiser.a
+HEADERS += ../DijkstraVisualiser/widget.h \
+           ../DijkstraVisualiser/node.h \
+           ../DijkstraVisualiser/edge.h \
+           ../DijkstraVisualiser/questionprefetcher.h \
+           ../DijkstraVisualiser/renderstyle.h \
+           ../DijkstraVisualiser/edgebatchitem.h \
+           ../DijkstraVisualiser/graphtablemodel.h \
+           ../DijkstraVisualiser/questionbankfile.h \
+           ../DijkstraVisualiser/graphregionitem.h
 
-# Google Test
-INCLUDEPATH += $$PWD/../googletest/googletest/include
-LIBS += -L$$PWD/../googletest/build/lib -lgtest -lgtest_main
+FORMS += ../DijkstraVisualiser/widget.ui
+
+# Headless graph core
+include(../GraphCore/GraphCore.pri)
+
+# Google Test, from a build next to the project if there is one, otherwise the system install
+exists($$PWD/../googletest/build/lib) {
+    INCLUDEPATH += $$PWD/../googletest/googletest/include
+    LIBS += -L$$PWD/../googletest/build/lib
+}
+LIBS += -lgtest
+unix: LIBS += -lpthread
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include "allpairs.h"
+#include "question.h"
+
+// Builds a random graph with a mix of directed and undirected edges, and some nodes left unreachable
+static Graph randomGraph(int numNodes, int numEdges, int maxWeight, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> node(0, numNodes - 1);
+    std::uniform_int_distribution<int> weight(0, maxWeight);
+    std::bernoulli_distribution directed(0.4);
+
+    std::vector<Point> positions(numNodes);
+    std::vector<GraphEdge> edges;
+    for (int i = 0; i < numEdges; i++) {
+        int a = node(rng);
+        int b = node(rng);
+        if (a != b) {
+            edges.push_back({a, b, weight(rng), directed(rng)});
+        }
+    }
+    return Graph(positions, edges);
+}
+
+// Checks a matrix against one Dijkstra search per row
+static void expectMatchesDijkstra(const Graph &graph, const DistanceMatrix &matrix) {
+    ASSERT_EQ(matrix.nodeCount, graph.nodeCount());
+    ASSERT_EQ(matrix.distances.size(), size_t(graph.nodeCount()) * graph.nodeCount());
+    for (int from = 0; from < graph.nodeCount(); from++) {
+        const SearchResult result = dijkstra(graph, from);
+        for (int to = 0; to < graph.nodeCount(); to++) {
+            ASSERT_EQ(matrix.at(from, to), result.distance[to]) << from << " -> " << to;
+        }
+    }
+}
+
+// Test both strategies agree with Dijkstra on sizes that do and do not fill whole tiles
+TEST(AllPairsTest, StrategiesMatchDijkstra) {
+    WorkStealingPool pool(4);
+    unsigned seed = 1;
+    for (int numNodes : {1, 5, 32, 70}) {
+        for (int numEdges : {numNodes, numNodes * 8}) {
+            for (int maxWeight : {MaxGeneratedWeight, 1000}) {
+                const Graph graph = randomGraph(numNodes, numEdges, maxWeight, seed++);
+                expectMatchesDijkstra(graph, floydWarshall(graph));
+                expectMatchesDijkstra(graph, repeatedDijkstra(graph));
+                expectMatchesDijkstra(graph, repeatedDijkstra(graph, &pool));
+                expectMatchesDijkstra(graph, allPairs(graph, &pool));
+            }
+        }
+    }
+}
+
+// Test weights too heavy for the padded matrix still give exact distances
+TEST(AllPairsTest, HeavyWeights) {
+    const int heavy = std::numeric_limits<int>::max() / 3;
+    const Graph graph({{}, {}, {}}, {{0, 1, heavy, true}, {1, 2, heavy, true}});
+    const DistanceMatrix matrix = floydWarshall(graph);
+    EXPECT_EQ(matrix.at(0, 2), 2 * heavy);
+    EXPECT_EQ(matrix.at(2, 0), Unreachable);
+}
+
+// Test the all-pairs table agrees with the generator's questions, for every graph type
+TEST(AllPairsTest, AgreesWithGeneratedQuestions) {
+    for (int graphType = 0; graphType < 3; graphType++) {
+        GeneratorConfig config;
+        config.graphType = graphType;
+        config.directed = graphType == 1;
+        config.sceneWidth = graphType == 2 ? 4000 : 771;
+        config.sceneHeight = graphType == 2 ? 2400 : 600;
+        for (uint64_t seed = 1; seed <= 5; seed++) {
+            const Question question = QuestionPipeline(config, SolverMode::Dijkstra).generate(seed);
+            const DistanceMatrix matrix = allPairs(question.graph);
+            EXPECT_EQ(matrix.at(question.startNode, question.endNode), question.path.distance);
+        }
+    }
+}
+
+// Test an empty graph gives an empty table
+TEST(AllPairsTest, EmptyGraph) {
+    EXPECT_EQ(allPairs(Graph()).nodeCount, 0);
+    EXPECT_TRUE(floydWarshall(Graph()).distances.empty());
+    EXPECT_TRUE(repeatedDijkstra(Graph()).distances.empty());
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "crossinggraph.h"
+#include "graphgenerator.h"
+
+// Random segments on a small grid, so shared end points, collinear overlaps and collapsed segments all occur
+static std::vector<Segment> randomSegments(int count, uint64_t seed) {
+    Random random(seed);
+    std::vector<Segment> segments;
+    for (int i = 0; i < count; i++) {
+        Point p1{double(random.bounded(20)), double(random.bounded(20))};
+        Point p2 = random.bounded(10) == 0 ? p1 : Point{double(random.bounded(20)), double(random.bounded(20))};
+        segments.push_back(Segment{p1, p2});
+    }
+    return segments;
+}
+
+// The pruning loop before the crossing graph, kept as the reference result
+static std::vector<GraphEdge> bruteForcePrune(const GraphGenerator &generator, const GraphLayout &layout, int limit) {
+    std::vector<GraphEdge> edges = layout.edges;
+    std::vector<Segment> segments = generator.edgeSegments(layout);
+    for (;;) {
+        int worstEdge = -1;
+        int worstCount = -1;
+        for (int i = 0; i < int(segments.size()); i++) {
+            int count = generator.countIntersectionsForEdge(i, segments);
+            if (count > worstCount) {
+                worstCount = count;
+                worstEdge = i;
+            }
+        }
+        if (worstEdge == -1 || worstCount < limit) {
+            return edges;
+        }
+        edges.erase(edges.begin() + worstEdge);
+        segments.erase(segments.begin() + worstEdge);
+    }
+}
+
+// Test the sweep finds exactly the crossings of the pairwise predicate
+TEST(CrossingGraphTest, CountsMatchPairwiseTest) {
+    GeneratorConfig config;
+    Random random(1);
+    GraphGenerator generator(config, random);
+
+    for (uint64_t seed = 1; seed <= 50; seed++) {
+        std::vector<Segment> segments = randomSegments(60, seed);
+        CrossingGraph crossings(segments);
+        ASSERT_EQ(crossings.size(), int(segments.size()));
+        for (int edge = 0; edge < crossings.size(); edge++) {
+            EXPECT_EQ(crossings.crossingCount(edge), generator.countIntersectionsForEdge(edge, segments));
+        }
+    }
+}
+
+// Test removing an edge lowers exactly the counts of the edges it crossed
+TEST(CrossingGraphTest, RemoveUpdatesCountsTest) {
+    std::vector<Segment> segments{{{0, 0}, {10, 10}}, {{0, 10}, {10, 0}}, {{5, 0}, {5, 10}}, {{20, 0}, {30, 0}}};
+    CrossingGraph crossings(segments);
+    EXPECT_EQ(crossings.crossingCount(0), 2);
+    EXPECT_EQ(crossings.crossingCount(1), 2);
+    EXPECT_EQ(crossings.crossingCount(2), 2);
+    EXPECT_EQ(crossings.crossingCount(3), 0);
+
+    // Ties go to the lowest index, as the first edge found used to
+    EXPECT_EQ(crossings.mostCrossedEdge(), 0);
+    crossings.remove(0);
+    EXPECT_TRUE(crossings.isRemoved(0));
+    EXPECT_EQ(crossings.crossingCount(1), 1);
+    EXPECT_EQ(crossings.crossingCount(2), 1);
+    EXPECT_EQ(crossings.mostCrossedEdge(), 1);
+
+    crossings.remove(1);
+    crossings.remove(2);
+    EXPECT_EQ(crossings.mostCrossedEdge(), 3);
+    crossings.remove(3);
+    EXPECT_EQ(crossings.mostCrossedEdge(), -1);
+}
+
+// Test pruning keeps exactly the edges the restart-from-scratch loop kept
+TEST(CrossingGraphTest, PruningMatchesBruteForceTest) {
+    for (int graphType : {0, 1}) {
+        GeneratorConfig config;
+        config.graphType = graphType;
+        for (uint64_t seed = 1; seed <= 100; seed++) {
+            Random random(seed);
+            GraphGenerator generator(config, random);
+            GraphLayout layout = generator.generateNodes(generator.generateColumnCount());
+            generator.generateEdges(layout);
+
+            std::vector<GraphEdge> expected = bruteForcePrune(generator, layout, config.intersectionLimit);
+            generator.removeEdgesWithHighIntersections(layout);
+
+            ASSERT_EQ(layout.edges.size(), expected.size()) << "seed " << seed;
+            for (size_t i = 0; i < expected.size(); i++) {
+                EXPECT_EQ(layout.edges[i].source, expected[i].source);
+                EXPECT_EQ(layout.edges[i].dest, expected[i].dest);
+            }
+        }
+    }
+}
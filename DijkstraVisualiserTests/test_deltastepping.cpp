@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "deltastepping.h"
+
+// Builds a random graph with a mix of directed and undirected edges, and some nodes left unreachable
+static Graph randomGraph(int numNodes, int numEdges, int minWeight, int maxWeight, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> node(0, numNodes - 1);
+    std::uniform_int_distribution<int> weight(minWeight, maxWeight);
+    std::bernoulli_distribution directed(0.4);
+
+    std::vector<Point> positions(numNodes);
+    std::vector<GraphEdge> edges;
+    for (int i = 0; i < numEdges; i++) {
+        int a = node(rng);
+        int b = node(rng);
+        if (a != b) {
+            edges.push_back({a, b, weight(rng), directed(rng)});
+        }
+    }
+    return Graph(positions, edges);
+}
+
+// Checks a search against Dijkstra, and that every predecessor lies on a shortest path
+static void expectMatchesDijkstra(const Graph &graph, const SearchResult &actual, int startNode) {
+    const SearchResult expected = dijkstra(graph, startNode);
+    ASSERT_EQ(actual.distance, expected.distance);
+    EXPECT_EQ(actual.settled, expected.settled);
+    for (int node = 0; node < graph.nodeCount(); node++) {
+        const int previous = actual.predecessor[node];
+        if (node == startNode || actual.distance[node] == Unreachable) {
+            EXPECT_EQ(previous, -1);
+            EXPECT_EQ(actual.predecessorEdge[node], -1);
+            continue;
+        }
+        ASSERT_NE(previous, -1) << node;
+        const GraphEdge &e = graph.edge(actual.predecessorEdge[node]);
+        EXPECT_TRUE((e.source == previous && e.dest == node) || (!e.directed && e.source == node && e.dest == previous));
+        EXPECT_EQ(actual.distance[previous] + e.weight, actual.distance[node]) << previous << " -> " << node;
+    }
+}
+
+// Test the distances match Dijkstra across bucket widths, weight ranges and thread counts, on frontiers
+// both below and above the parallel threshold
+TEST(DeltaSteppingTest, MatchesDijkstra) {
+    WorkStealingPool pool(4);
+    unsigned seed = 1;
+    for (int numNodes : {1, 40, 4 * ParallelFrontier}) {
+        for (int maxWeight : {MaxGeneratedWeight, 1000}) {
+            const Graph graph = randomGraph(numNodes, numNodes * 4, 0, maxWeight, seed++);
+            for (int delta : {0, 1, 3, maxWeight + 1}) {
+                DeltaStepping sequential(nullptr, delta);
+                DeltaStepping parallel(&pool, delta);
+                for (int startNode : {0, numNodes / 2}) {
+                    expectMatchesDijkstra(graph, sequential.run(graph, startNode), startNode);
+                    expectMatchesDijkstra(graph, parallel.run(graph, startNode), startNode);
+                }
+            }
+        }
+    }
+}
+
+// Test the predecessors do not depend on the thread count or bucket width
+TEST(DeltaSteppingTest, DeterministicPredecessors) {
+    const Graph graph = randomGraph(8 * ParallelFrontier, 32 * ParallelFrontier, 1, 3, 7);
+    const std::vector<int> expected = DeltaStepping().run(graph, 0).predecessor;
+    WorkStealingPool pool(4);
+    for (int delta : {1, 2, 5}) {
+        DeltaStepping search(&pool, delta);
+        for (int run = 0; run < 3; run++) {
+            EXPECT_EQ(search.run(graph, 0).predecessor, expected);
+        }
+    }
+}
+
+// Test a cycle of zero weight arcs still leaves the predecessors a tree
+TEST(DeltaSteppingTest, ZeroWeightCycle) {
+    const Graph graph({{}, {}, {}, {}, {}}, {{0, 3, 1, true}, {0, 4, 1, true}, {1, 2, 0, false},
+                                             {3, 1, 0, true}, {4, 2, 0, true}});
+    DeltaStepping search;
+    const SearchResult &result = search.run(graph, 0);
+    expectMatchesDijkstra(graph, result, 0);
+    for (int node = 1; node < graph.nodeCount(); node++) {
+        int hops = 0;
+        for (int current = node; current != 0; current = result.predecessor[current]) {
+            ASSERT_LT(++hops, graph.nodeCount()) << node;
+        }
+    }
+}
+
+// Test the solver mode answers start -> end queries like Dijkstra
+TEST(DeltaSteppingTest, SolverMode) {
+    const Graph graph = randomGraph(300, 900, 1, MaxGeneratedWeight, 11);
+    for (int endNode = 0; endNode < graph.nodeCount(); endNode += 7) {
+        const PathResult expected = shortestPath(graph, 0, endNode, SolverMode::Dijkstra);
+        const PathResult actual = shortestPath(graph, 0, endNode, SolverMode::DeltaStepping);
+        ASSERT_EQ(actual.distance, expected.distance);
+        if (actual.distance == Unreachable) {
+            EXPECT_TRUE(actual.edges.empty());
+            continue;
+        }
+        int total = 0;
+        for (int edge : actual.edges) {
+            total += graph.edges()[edge].weight;
+        }
+        EXPECT_EQ(total, actual.distance);
+    }
+}
@@ -7,10 +7,10 @@ class EdgeTest : public ::testing::Test {
 protected:
     void SetUp() override {
         // Initialize common objects before each test
-        nodeA = new Node('A', 0);
-        nodeB = new Node('B', 1);
-        nodeC = new Node('C', 2);
-        nodeD = new Node('D', 3);
+        nodeA = new Node(0, 0);
+        nodeB = new Node(1, 1);
+        nodeC = new Node(2, 2);
+        nodeD = new Node(3, 3);
 
         // Set positions for nodes to create intersecting edges
         nodeA->setPos(0, 0);
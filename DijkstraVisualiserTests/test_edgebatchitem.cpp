@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include "edge.h"
+#include "edgebatchitem.h"
+#include "node.h"
+
+// Test fixture with a small chain of nodes and edges
+class EdgeBatchItemTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (int i = 0; i < 4; i++) {
+            nodes.append(new Node(i, i));
+            nodes[i]->setPos(100 * i, 50 * (i % 2));
+        }
+        for (int i = 0; i < 3; i++) {
+            edges.append(new Edge(nodes[i], nodes[i + 1], i == 1, i + 1));
+        }
+    }
+
+    void TearDown() override {
+        qDeleteAll(edges);
+        qDeleteAll(nodes);
+    }
+
+    QList<Node*> nodes;
+    QList<Edge*> edges;
+};
+
+// Test the batch holds one line per edge, covering every edge
+TEST_F(EdgeBatchItemTest, BatchesEveryLine) {
+    EdgeBatchItem batch(edges);
+    EXPECT_EQ(batch.path().elementCount(), 2 * edges.size()); // A move and a line per edge
+    for (Edge *edge : edges) {
+        EXPECT_TRUE(batch.boundingRect().contains(edge->getSourcePoint()));
+        EXPECT_TRUE(batch.boundingRect().contains(edge->getDestPoint()));
+    }
+    EXPECT_LT(batch.zValue(), edges.first()->zValue());
+    EXPECT_EQ(batch.cacheMode(), QGraphicsItem::DeviceCoordinateCache);
+}
+
+// Test batched edges hide unless highlighted, and come back when unbatched
+TEST_F(EdgeBatchItemTest, BatchedEdgesHideUnlessHighlighted) {
+    for (Edge *edge : edges) {
+        edge->setBatched(true);
+        EXPECT_FALSE(edge->isVisible());
+    }
+
+    edges[1]->setEdgeColour(Qt::green); // A highlighted path edge stays on top of the batch
+    EXPECT_TRUE(edges[1]->isVisible());
+    edges[1]->setEdgeColour(Qt::black);
+    EXPECT_FALSE(edges[1]->isVisible());
+
+    for (Edge *edge : edges) {
+        edge->setBatched(false);
+        EXPECT_TRUE(edge->isVisible());
+    }
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "graph.h"
+#include "shortestpath.h"
+
+// Test fixture for the graph core
+class GraphTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Diamond A -> B -> D and A - C - D, with a directed shortcut B -> C
+        std::vector<Point> positions = {{0, 0}, {100, -50}, {100, 50}, {200, 0}};
+        std::vector<GraphEdge> edges = {
+            {0, 1, 2, true},
+            {1, 3, 7, true},
+            {0, 2, 5, false},
+            {2, 3, 3, false},
+            {1, 2, 1, true},
+        };
+        graph = Graph(positions, edges);
+    }
+
+    Graph graph;
+};
+
+// Test node and edge counts
+TEST_F(GraphTest, Counts) {
+    ASSERT_EQ(graph.nodeCount(), 4);
+    ASSERT_EQ(graph.edgeCount(), 5);
+    ASSERT_EQ(graph.position(3).x, 200);
+}
+
+// Test that directed edges only appear forwards and undirected edges appear both ways
+TEST_F(GraphTest, ForwardAndReverseArcs) {
+    ASSERT_EQ(graph.outArcs(0).size(), 2); // 0 -> 1, 0 - 2
+    ASSERT_EQ(graph.inArcs(0).size(), 1); // 2 - 0
+    ASSERT_EQ(graph.outArcs(1).size(), 2); // 1 -> 3, 1 -> 2
+    ASSERT_EQ(graph.inArcs(1).size(), 1); // 0 -> 1
+    ASSERT_EQ(graph.outArcs(3).size(), 1); // 3 - 2
+    ASSERT_EQ(graph.inArcs(3).size(), 2); // 1 -> 3, 2 - 3
+
+    for (int node = 0; node < graph.nodeCount(); node++) {
+        for (const Arc &arc : graph.outArcs(node)) {
+            const GraphEdge &e = graph.edge(arc.edge);
+            ASSERT_EQ(arc.weight, e.weight);
+            ASSERT_TRUE((e.source == node && e.dest == arc.node) || (!e.directed && e.dest == node && e.source == arc.node));
+        }
+    }
+}
+
+// Test edge lookup respects direction
+TEST_F(GraphTest, FindEdge) {
+    ASSERT_EQ(graph.findEdge(0, 1), 0);
+    ASSERT_EQ(graph.findEdge(1, 0), -1);
+    ASSERT_EQ(graph.findEdge(2, 0), 2);
+    ASSERT_EQ(graph.findEdge(3, 1), -1);
+}
+
+// Test Dijkstra distances and path reconstruction
+TEST_F(GraphTest, Dijkstra) {
+    SearchResult result = dijkstra(graph, 0);
+    ASSERT_EQ(result.distance[0], 0);
+    ASSERT_EQ(result.distance[1], 2);
+    ASSERT_EQ(result.distance[2], 3);
+    ASSERT_EQ(result.distance[3], 6);
+    ASSERT_EQ(result.settled, 4);
+
+    std::vector<int> path = pathEdges(result, 3);
+    ASSERT_EQ(path, (std::vector<int>{0, 4, 3}));
+
+    // Only the undirected edges lead back out of the end node
+    SearchResult reverse = dijkstra(graph, 3);
+    ASSERT_EQ(reverse.distance[0], 8);
+    ASSERT_EQ(reverse.distance[1], 10);
+    ASSERT_EQ(pathEdges(reverse, 1), (std::vector<int>{3, 2, 0}));
+
+    // Nothing leads into a node with only outgoing directed edges
+    Graph source({{0, 0}, {10, 0}}, {{0, 1, 4, true}});
+    ASSERT_EQ(dijkstra(source, 1).distance[0], Unreachable);
+}
@@ -0,0 +1,227 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <set>
+#include "graphgenerator.h"
+#include "shortestpath.h"
+
+// Test fixture for the headless graph generator
+class GraphGeneratorTest : public ::testing::Test {
+protected:
+    GeneratorConfig config; // Basic undirected graphs
+    Random random{12345};
+    GraphGenerator generator{config, random};
+};
+
+// Test the random source gives the reference xoshiro256** sequence, so seeds match on every platform
+TEST(RandomTest, MatchesReferenceSequence) {
+    Random random(0);
+    EXPECT_EQ(random.next(), 0x99ec5f36cb75f2b4u);
+    EXPECT_EQ(random.next(), 0xbf6e1f784956452au);
+    EXPECT_EQ(random.next(), 0x1a5f849d4933e6e0u);
+}
+
+// Test bounded values stay in range and a shuffle keeps every item
+TEST(RandomTest, BoundedAndShuffle) {
+    Random random(7);
+    std::vector<int> hits(6, 0);
+    for (int i = 0; i < 6000; i++) {
+        int value = random.bounded(-2, 4);
+        ASSERT_GE(value, -2);
+        ASSERT_LT(value, 4);
+        hits[value + 2]++;
+    }
+    for (int count : hits) {
+        EXPECT_GT(count, 800);
+    }
+
+    std::vector<int> items{0, 1, 2, 3, 4, 5, 6, 7};
+    random.shuffle(items);
+    EXPECT_NE(items, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7}));
+    std::sort(items.begin(), items.end());
+    EXPECT_EQ(items, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7}));
+}
+
+// Test generating nodes for uniqueness and constraints
+TEST_F(GraphGeneratorTest, GenerateNodesUniqueAndConstraintsTest) {
+    int numOfColumns = 4; // Define the number of columns for the test
+
+    GraphLayout layout = generator.generateNodes(numOfColumns);
+    int numNodes = int(layout.positions.size());
+
+    // Check if the number of nodes is within the expected range
+    EXPECT_GE(numNodes, numOfColumns); // Minimum number of nodes should be equal to the number of columns
+    EXPECT_LE(numNodes, numOfColumns * 6); // Maximum number of nodes based on the provided logic
+    ASSERT_EQ(layout.columns.size(), layout.positions.size());
+
+    // Check the start and end nodes sit in the first and last columns
+    EXPECT_EQ(layout.columns.front(), 0);
+    EXPECT_EQ(layout.columns.back(), numOfColumns - 1);
+
+    // Check if all nodes have distinct positions inside the scene
+    std::set<std::pair<double, double>> uniquePositions;
+    for (const Point &p : layout.positions) {
+        uniquePositions.insert({p.x, p.y});
+        EXPECT_GT(p.x, 0);
+        EXPECT_LT(p.x, config.sceneWidth);
+        EXPECT_GT(p.y, 0);
+        EXPECT_LT(p.y, config.sceneHeight);
+    }
+    EXPECT_EQ(int(uniquePositions.size()), numNodes);
+}
+
+// Test generating edges for uniqueness and constraints
+TEST_F(GraphGeneratorTest, GenerateEdgesUniqueAndConstraintsTest) {
+    GraphLayout layout = generator.generateNodes(4);
+    ASSERT_FALSE(layout.positions.empty());
+    generator.generateEdges(layout);
+
+    // Check if edges are not empty
+    EXPECT_FALSE(layout.edges.empty());
+
+    // Check if all edges join two different nodes and no pair is joined twice
+    std::set<std::pair<int, int>> uniqueEdges;
+    for (const GraphEdge &edge : layout.edges) {
+        EXPECT_NE(edge.source, edge.dest);
+        uniqueEdges.insert({std::min(edge.source, edge.dest), std::max(edge.source, edge.dest)});
+    }
+    EXPECT_EQ(uniqueEdges.size(), layout.edges.size());
+
+    // Check if all edges have weights in the generator's range and none are directed
+    for (const GraphEdge &edge : layout.edges) {
+        EXPECT_GT(edge.weight, 0);
+        EXPECT_LE(edge.weight, MaxGeneratedWeight);
+        EXPECT_FALSE(edge.directed);
+    }
+}
+
+// Test length-proportional weights spread over the whole weight range and never make a longer edge lighter
+TEST(GraphGeneratorWeightTest, ProportionalWeightsFollowLength) {
+    for (int graphType : {0, 1, 2}) {
+        GeneratorConfig config;
+        config.graphType = graphType;
+        config.proportionalWeights = true;
+        Random random(99);
+        GraphGenerator generator(config, random);
+
+        for (int trial = 0; trial < 10; trial++) {
+            GraphLayout layout = generator.generateNodes(generator.generateColumnCount());
+            generator.generateEdges(layout);
+            std::vector<std::pair<double, int>> byLength; // (length, weight) of every edge
+            for (const GraphEdge &edge : layout.edges) {
+                byLength.push_back({distance(layout.positions[edge.source], layout.positions[edge.dest]), edge.weight});
+            }
+            std::sort(byLength.begin(), byLength.end());
+            for (size_t i = 1; i < byLength.size(); i++) {
+                EXPECT_LE(byLength[i - 1].second, byLength[i].second);
+            }
+            EXPECT_GE(byLength.front().second, 1);
+            EXPECT_EQ(byLength.back().second, MaxGeneratedWeight);
+
+            // The chain kept aside for connectStartToEnd carries the same weights
+            for (int i = 0; i < int(layout.spanningPath.size()); i++) {
+                EXPECT_EQ(layout.spanningPath[i].weight, layout.edges[i].weight);
+            }
+        }
+    }
+}
+
+// Test removing edges with high intersections
+TEST_F(GraphGeneratorTest, RemoveEdgesWithHighIntersectionsTest) {
+    for (int trial = 0; trial < 20; trial++) {
+        GraphLayout layout = generator.generateNodes(generator.generateColumnCount());
+        generator.generateEdges(layout);
+        size_t initialEdges = layout.edges.size();
+
+        generator.removeEdgesWithHighIntersections(layout);
+
+        // Verify that remaining edges have intersections below the limit
+        std::vector<Segment> segments = generator.edgeSegments(layout);
+        for (int edge = 0; edge < int(segments.size()); edge++) {
+            EXPECT_LT(generator.countIntersectionsForEdge(edge, segments), config.intersectionLimit);
+        }
+        EXPECT_LE(layout.edges.size(), initialEdges);
+    }
+}
+
+// Test removing node-intersecting edges
+TEST_F(GraphGeneratorTest, RemoveNodeIntersectingEdgesTest) {
+    GraphLayout layout = generator.generateNodes(4);
+    generator.generateEdges(layout);
+    std::vector<GraphEdge> initialEdges = layout.edges;
+
+    generator.removeNodeIntersectingEdges(layout);
+
+    // Verify that edges passing near nodes (except their source and destination nodes) have been removed
+    size_t kept = 0;
+    for (const GraphEdge &edge : initialEdges) {
+        Segment segment = edgeSegment(layout.positions[edge.source], layout.positions[edge.dest]);
+        bool intersectsNode = false;
+        for (int node = 0; node < int(layout.positions.size()) && !intersectsNode; node++) {
+            if (node == edge.source || node == edge.dest) {
+                continue; // Skip this node, as it's part of the edge
+            }
+            intersectsNode = distanceToSegment(layout.positions[node], segment) < config.nodeClearance;
+        }
+
+        bool remains = false;
+        for (const GraphEdge &e : layout.edges) {
+            remains = remains || (e.source == edge.source && e.dest == edge.dest);
+        }
+        EXPECT_EQ(remains, !intersectsNode);
+        kept += remains;
+    }
+    EXPECT_EQ(kept, layout.edges.size());
+}
+
+// Test the chain is restored only as far as the end node needs, and a start -> end edge is dropped
+TEST_F(GraphGeneratorTest, ConnectStartToEndTest) {
+    GraphLayout layout = generator.generateNodes(4);
+    generator.generateEdges(layout);
+    const int endNode = int(layout.positions.size()) - 1;
+    ASSERT_EQ(int(layout.spanningPath.size()), endNode);
+
+    // Nothing changes when the end is already in reach
+    const std::vector<GraphEdge> generated = layout.edges;
+    EXPECT_EQ(generator.connectStartToEnd(layout), 0);
+    EXPECT_EQ(layout.edges.size(), generated.size());
+
+    // With every edge pruned, the whole chain comes back
+    layout.edges.clear();
+    EXPECT_EQ(generator.connectStartToEnd(layout), endNode);
+    EXPECT_EQ(int(layout.edges.size()), endNode);
+    const Graph chain(layout.positions, layout.edges);
+    EXPECT_EQ(int(shortestPath(chain, 0, endNode, SolverMode::Dijkstra).edges.size()), endNode);
+
+    // A pruned first edge is all that is restored when the rest of the chain survived
+    layout.edges.assign(layout.spanningPath.begin() + 1, layout.spanningPath.end());
+    layout.edges.push_back(GraphEdge{0, endNode, 1, false});
+    EXPECT_EQ(generator.connectStartToEnd(layout), 1);
+    EXPECT_EQ(layout.edges.size(), layout.spanningPath.size());
+    for (const GraphEdge &edge : layout.edges) {
+        EXPECT_FALSE(edge.source == 0 && edge.dest == endNode);
+    }
+}
+
+// Test the exact point to segment distance
+TEST(GeometryTest, DistanceToSegment) {
+    Segment segment{{0, 0}, {10, 0}};
+    EXPECT_DOUBLE_EQ(distanceToSegment({5, 3}, segment), 3); // Closest to the interior
+    EXPECT_DOUBLE_EQ(distanceToSegment({-3, 4}, segment), 5); // Closest to the first end
+    EXPECT_DOUBLE_EQ(distanceToSegment({13, -4}, segment), 5); // Closest to the second end
+    EXPECT_DOUBLE_EQ(distanceToSegment({3, 4}, Segment{{0, 0}, {0, 0}}), 5); // Collapsed segment
+}
+
+// Test the segment intersection matches the crossing edges used by the Edge tests
+TEST(GeometryTest, SegmentsIntersect) {
+    Segment edge1 = edgeSegment({0, 0}, {100, 100});
+    Segment edge2 = edgeSegment({100, 0}, {0, 100});
+    EXPECT_TRUE(segmentsIntersect(edge1, edge2));
+    EXPECT_TRUE(segmentsIntersect(edge2, edge1));
+
+    // Parallel and collapsed segments never intersect
+    EXPECT_FALSE(segmentsIntersect(Segment{{0, 0}, {10, 0}}, Segment{{5, 0}, {20, 0}}));
+    EXPECT_FALSE(segmentsIntersect(edgeSegment({0, 0}, {20, 0}), edge1));
+
+    // Segments meeting at an end point count as intersecting
+    EXPECT_TRUE(segmentsIntersect(Segment{{0, 0}, {10, 0}}, Segment{{10, 0}, {10, 10}}));
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include "graphimporter.h"
+
+// Options reading a few bytes at a time, so most lines straddle two chunks
+static ImportOptions tinyChunks() {
+    ImportOptions options;
+    options.chunkSize = 5;
+    return options;
+}
+
+// Test a DIMACS graph is read with its coordinates, whatever the chunk size
+TEST(GraphImporterTest, ReadsDimacsWithCoordinates) {
+    const std::string arcs = "c road network\np sp 3 3\na 1 2 7\na 2 3 4\r\na 3 1 10";
+    const std::string coordinates = "c coordinates\np aux sp co 3\nv 1 0 0\nv 2 100 0\nv 3 100 200\n";
+
+    for (size_t chunkSize : {size_t(1), size_t(5), size_t(1) << 20}) {
+        ImportOptions options;
+        options.chunkSize = chunkSize;
+        std::istringstream in(arcs);
+        std::istringstream co(coordinates);
+        ImportResult result = importGraph(in, GraphFormat::Dimacs, options, &co);
+        ASSERT_TRUE(result.ok()) << result.error;
+        EXPECT_TRUE(result.hasCoordinates);
+
+        const Graph &graph = result.graph;
+        ASSERT_EQ(graph.nodeCount(), 3);
+        ASSERT_EQ(graph.edgeCount(), 3);
+        EXPECT_EQ(graph.edge(0).source, 0);
+        EXPECT_EQ(graph.edge(0).dest, 1);
+        EXPECT_EQ(graph.edge(0).weight, 7);
+        EXPECT_TRUE(graph.edge(0).directed);
+        EXPECT_EQ(graph.edge(2).weight, 10);
+        EXPECT_EQ(graph.findEdge(1, 0), -1);
+
+        // North is at the top of the scene and the shape is kept
+        EXPECT_LT(graph.position(2).y, graph.position(1).y);
+        EXPECT_DOUBLE_EQ(graph.position(0).y, graph.position(1).y);
+        EXPECT_DOUBLE_EQ(graph.position(1).x, graph.position(2).x);
+        EXPECT_NEAR((graph.position(1).y - graph.position(2).y) / (graph.position(1).x - graph.position(0).x), 2.0,
+                    1e-9);
+    }
+}
+
+// Test an edge list with comments, default weights and loops, laid out on a grid
+TEST(GraphImporterTest, ReadsEdgeList) {
+    std::istringstream in("# from to weight\n0 1\n1\t4 3\n\n% comment\n2,3,5\n4 4 1\n");
+    ImportOptions options = tinyChunks();
+    options.directed = false;
+    ImportResult result = importGraph(in, GraphFormat::EdgeList, options);
+    ASSERT_TRUE(result.ok()) << result.error;
+    EXPECT_FALSE(result.hasCoordinates);
+
+    const Graph &graph = result.graph;
+    ASSERT_EQ(graph.nodeCount(), 5);
+    ASSERT_EQ(graph.edgeCount(), 3); // The loop at node 4 is dropped
+    EXPECT_EQ(graph.edge(0).weight, 1);
+    EXPECT_EQ(graph.edge(1).weight, 3);
+    EXPECT_EQ(graph.edge(2).weight, 5);
+    EXPECT_FALSE(graph.edge(0).directed);
+    EXPECT_EQ(graph.findEdge(4, 1), 1);
+
+    // Three columns, one spacing apart
+    EXPECT_DOUBLE_EQ(graph.position(0).x, options.nodeSpacing);
+    EXPECT_DOUBLE_EQ(graph.position(4).x, 2 * options.nodeSpacing);
+    EXPECT_DOUBLE_EQ(graph.position(4).y, 2 * options.nodeSpacing);
+}
+
+// Test symmetric MatrixMarket entries become undirected edges with rounded weights, general ones directed
+TEST(GraphImporterTest, ReadsMatrixMarket) {
+    std::istringstream symmetric("%%MatrixMarket matrix coordinate real symmetric\n% comment\n3 3 4\n"
+                                 "1 1 2.0\n2 1 -2.6\n3 2 0.001\n3 1 1.5e1\n");
+    ImportResult result = importGraph(symmetric, GraphFormat::MatrixMarket, tinyChunks());
+    ASSERT_TRUE(result.ok()) << result.error;
+    ASSERT_EQ(result.graph.nodeCount(), 3);
+    ASSERT_EQ(result.graph.edgeCount(), 3); // The diagonal entry is a loop
+    EXPECT_EQ(result.graph.edge(0).weight, 3);
+    EXPECT_EQ(result.graph.edge(1).weight, 1);
+    EXPECT_EQ(result.graph.edge(2).weight, 15);
+    EXPECT_FALSE(result.graph.edge(0).directed);
+
+    std::istringstream pattern("%%MatrixMarket matrix coordinate pattern general\n2 4 2\n1 4\n2 3\n");
+    result = importGraph(pattern, GraphFormat::MatrixMarket, tinyChunks());
+    ASSERT_TRUE(result.ok()) << result.error;
+    EXPECT_EQ(result.graph.nodeCount(), 4);
+    EXPECT_EQ(result.graph.findEdge(0, 3), 0);
+    EXPECT_EQ(result.graph.findEdge(3, 0), -1);
+    EXPECT_EQ(result.graph.edge(1).weight, 1);
+}
+
+// Test malformed files are refused with the line at fault
+TEST(GraphImporterTest, ReportsErrors) {
+    std::istringstream outOfRange("p sp 2 1\na 1 3 4\n");
+    ImportResult result = importGraph(outOfRange, GraphFormat::Dimacs, tinyChunks());
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(result.error.rfind("line 2:", 0), 0u) << result.error;
+    EXPECT_EQ(result.graph.nodeCount(), 0);
+
+    std::istringstream noProblem("a 1 2 3\n");
+    EXPECT_FALSE(importGraph(noProblem, GraphFormat::Dimacs).ok());
+
+    std::istringstream badEdge("0 1\n1 x\n");
+    result = importGraph(badEdge, GraphFormat::EdgeList);
+    EXPECT_EQ(result.error.rfind("line 2:", 0), 0u) << result.error;
+
+    std::istringstream array("%%MatrixMarket matrix array real general\n2 2\n1\n2\n3\n4\n");
+    EXPECT_FALSE(importGraph(array, GraphFormat::MatrixMarket).ok());
+
+    std::istringstream arcs("p sp 2 1\na 1 2 4\n");
+    std::istringstream missing("v 1 0 0\n");
+    result = importGraph(arcs, GraphFormat::Dimacs, ImportOptions(), &missing);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(result.error.rfind("coordinates", 0), 0u) << result.error;
+}
+
+// Test formats are recognised by extension
+TEST(GraphImporterTest, FormatForFile) {
+    EXPECT_EQ(graphFormatForFile("USA-road-d.NY.gr"), GraphFormat::Dimacs);
+    EXPECT_EQ(graphFormatForFile("bcsstk01.MTX"), GraphFormat::MatrixMarket);
+    EXPECT_EQ(graphFormatForFile("roadNet-CA.txt"), GraphFormat::EdgeList);
+    EXPECT_EQ(graphFormatForFile("edges"), GraphFormat::EdgeList);
+    EXPECT_FALSE(importGraphFile("/nonexistent/graph.gr").ok());
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "geometry.h"
+#include "graphregionitem.h"
+
+// A row of four nodes 60 apart, joined in a chain with one directed edge back to the start
+static Graph chain() {
+    return Graph({{60, 60}, {120, 60}, {180, 60}, {240, 60}},
+                 {{0, 1, 1, false}, {1, 2, 1, false}, {2, 3, 1, false}, {3, 0, 1, true}});
+}
+
+// Test the item is sized to its nodes and finds the nodes of a region exactly
+TEST(GraphRegionItemTest, FindsNodesInRegion) {
+    GraphRegionItem item(chain(), 60);
+    EXPECT_EQ(item.graph().nodeCount(), 4);
+    EXPECT_LE(item.boundingRect().left(), 60 - NodeRadius);
+    EXPECT_GE(item.boundingRect().right(), 240 + NodeRadius);
+
+    std::vector<int> nodes = item.nodesIn(QRectF(100, 0, 90, 100));
+    std::sort(nodes.begin(), nodes.end());
+    EXPECT_EQ(nodes, (std::vector<int>{1, 2}));
+    EXPECT_TRUE(item.nodesIn(QRectF(0, 200, 500, 100)).empty());
+}
+
+// Test the edges crossing a region are collected once each, including an edge with both ends outside
+// it, and the collection stops once it is past the limit
+TEST(GraphRegionItemTest, CollectsEdgesOfRegion) {
+    GraphRegionItem item(chain(), 60);
+    std::vector<int> edges = item.edgesIn(QRectF(100, 0, 90, 100), 100);
+    std::sort(edges.begin(), edges.end());
+    EXPECT_EQ(edges, (std::vector<int>{0, 1, 2, 3}));
+
+    // Between nodes 1 and 2 only the middle edge and the edge back to the start pass
+    edges = item.edgesIn(QRectF(140, 50, 20, 20), 100);
+    std::sort(edges.begin(), edges.end());
+    EXPECT_EQ(edges, (std::vector<int>{1, 3}));
+    EXPECT_TRUE(item.edgesIn(QRectF(0, 200, 500, 100), 100).empty());
+    EXPECT_EQ(item.edgesIn(QRectF(0, 0, 300, 100), 1).size(), 2u);
+
+    // A long edge across a wide graph is found from a view in the middle of it
+    std::vector<Point> positions;
+    std::vector<GraphEdge> graphEdges;
+    for (int i = 0; i < 50; i++) {
+        positions.push_back(Point{60.0 * i, 0});
+        positions.push_back(Point{60.0 * i, 600});
+    }
+    graphEdges.push_back({0, 99, 1, false});
+    GraphRegionItem wide(Graph(positions, graphEdges), 60);
+    EXPECT_EQ(wide.edgesIn(QRectF(1400, 250, 100, 100), 100), (std::vector<int>{0}));
+    EXPECT_TRUE(wide.edgesIn(QRectF(1400, 0, 100, 100), 100).empty());
+}
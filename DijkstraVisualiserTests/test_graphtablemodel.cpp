@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <QBrush>
+#include "graphtablemodel.h"
+
+// Test fixture with a triangle A - B - C and a directed edge C -> A
+class GraphTableModelTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        model.setGraph(Graph({{0, 0}, {1, 0}, {0, 1}}, {{0, 1, 4, false}, {1, 2, 2, false}, {2, 0, 7, true}}),
+                       LabelStyle::Letters);
+    }
+
+    GraphTableModel model;
+};
+
+// Test the matrix has a cell per node pair holding the weight of the arc between them
+TEST_F(GraphTableModelTest, MatrixReadsWeightsFromArcs) {
+    EXPECT_EQ(model.representation(), Representation::Matrix);
+    EXPECT_EQ(model.rowCount(), 3);
+    EXPECT_EQ(model.columnCount(), 3);
+    EXPECT_EQ(model.headerData(2, Qt::Horizontal).toString(), "C");
+    EXPECT_EQ(model.headerData(1, Qt::Vertical).toString(), "B");
+
+    EXPECT_EQ(model.data(model.index(0, 1)).toInt(), 4);
+    EXPECT_EQ(model.data(model.index(1, 0)).toInt(), 4); // Undirected edges appear both ways
+    EXPECT_EQ(model.data(model.index(2, 0)).toInt(), 7);
+    EXPECT_EQ(model.data(model.index(0, 2)).toInt(), 0); // Against the arrow
+    EXPECT_EQ(model.data(model.index(0, 0)).toInt(), 0);
+
+    // Existing edges are highlighted in red
+    EXPECT_EQ(model.data(model.index(0, 1), Qt::ForegroundRole).value<QBrush>().color(), QColor(Qt::red));
+    EXPECT_FALSE(model.data(model.index(0, 0), Qt::ForegroundRole).isValid());
+}
+
+// Test the list has one row per node naming the nodes its arcs lead to
+TEST_F(GraphTableModelTest, ListShowsNeighbours) {
+    model.setRepresentation(Representation::List);
+    EXPECT_EQ(model.rowCount(), 3);
+    EXPECT_EQ(model.columnCount(), 1);
+    EXPECT_EQ(model.headerData(0, Qt::Vertical).toString(), "A");
+    EXPECT_EQ(model.data(model.index(0, 0)).toString(), "B(4)");
+    EXPECT_EQ(model.data(model.index(2, 0)).toString(), "B(2) A(7)");
+}
+
+// Test clearing leaves an empty table, and large graphs label their rows with separators
+TEST_F(GraphTableModelTest, ClearAndLargeGraphs) {
+    model.clear();
+    EXPECT_EQ(model.rowCount(), 0);
+    EXPECT_EQ(model.columnCount(), 0);
+
+    model.setGraph(Graph(std::vector<Point>(3000, Point{0, 0}), {{0, 2999, 3, false}}), LabelStyle::Letters);
+    EXPECT_EQ(model.rowCount(), 3000);
+    EXPECT_EQ(model.columnCount(), 3000); // Cells are only formatted when asked for
+    EXPECT_EQ(model.data(model.index(2999, 0)).toInt(), 3);
+    EXPECT_EQ(model.headerData(27, Qt::Vertical).toString(), "AB");
+}
+
+// Test the distance matrix holds shortest distances, with the asked for pair hidden both ways when the
+// way back gives it away
+TEST_F(GraphTableModelTest, DistanceMatrixHidesAskedPair) {
+    model.setRepresentation(Representation::Distances);
+    EXPECT_EQ(model.rowCount(), 3);
+    EXPECT_EQ(model.columnCount(), 3);
+    EXPECT_EQ(model.data(model.index(0, 2)).toInt(), 6); // A -> B -> C, the direct edge only runs C -> A
+    EXPECT_EQ(model.data(model.index(2, 0)).toInt(), 6); // C -> B -> A undercuts the direct edge of 7
+    EXPECT_EQ(model.data(model.index(1, 1)).toInt(), 0);
+
+    model.setHiddenDistance(0, 2);
+    EXPECT_EQ(model.data(model.index(0, 2)).toString(), "?");
+    EXPECT_EQ(model.data(model.index(0, 2), Qt::ForegroundRole).value<QBrush>().color(), QColor(Qt::blue));
+    EXPECT_EQ(model.data(model.index(2, 0)).toString(), "?"); // The way back would give the answer away
+    EXPECT_EQ(model.data(model.index(1, 0)).toInt(), 4);
+
+    // On a directed graph without an arc back, only the asked for cell is hidden
+    model.setGraph(Graph({{0, 0}, {1, 0}, {0, 1}}, {{0, 1, 4, true}, {1, 2, 2, true}, {2, 1, 3, true}, {1, 0, 5, true}}),
+                   LabelStyle::Letters);
+    model.setHiddenDistance(0, 2);
+    EXPECT_EQ(model.data(model.index(0, 2)).toString(), "?");
+    EXPECT_EQ(model.data(model.index(2, 0)).toInt(), 8); // C -> B -> A
+
+    // A new graph gets its own distances, with unreachable pairs shown as a dash
+    model.setHiddenDistance(-1, -1);
+    model.setGraph(Graph({{0, 0}, {1, 0}}, {{0, 1, 5, true}}), LabelStyle::Letters);
+    EXPECT_EQ(model.data(model.index(0, 1)).toInt(), 5);
+    EXPECT_EQ(model.data(model.index(1, 0)).toString(), "-");
+}
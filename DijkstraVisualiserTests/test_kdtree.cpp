@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "graphgenerator.h"
+#include "kdtree.h"
+
+// Test the nearest points come back in (distance, id) order, matching a full sort
+TEST(KdTreeTest, NearestMatchesSortedDistances) {
+    Random random(5);
+    for (int trial = 0; trial < 20; trial++) {
+        // Points on a coarse grid, so equal distances are common
+        std::vector<Point> points;
+        for (int i = 0; i < 200; i++) {
+            points.push_back(Point{double(random.bounded(30)), double(random.bounded(30))});
+        }
+        KdTree tree(points);
+
+        for (int query = 0; query < 10; query++) {
+            int skip = random.bounded(200);
+            std::vector<std::pair<double, int>> expected;
+            for (int id = 0; id < 200; id++) {
+                if (id != skip) {
+                    expected.push_back({distance(points[skip], points[id]), id});
+                }
+            }
+            std::sort(expected.begin(), expected.end());
+
+            for (int k : {1, 4, 17, 199, 300}) {
+                std::vector<int> nearest = tree.nearest(points[skip], k, skip);
+                ASSERT_EQ(nearest.size(), std::min<size_t>(k, expected.size()));
+                for (size_t i = 0; i < nearest.size(); i++) {
+                    EXPECT_EQ(nearest[i], expected[i].second);
+                }
+            }
+        }
+    }
+}
+
+// Test an empty tree returns no points
+TEST(KdTreeTest, EmptyTree) {
+    KdTree tree({});
+    EXPECT_TRUE(tree.nearest(Point{0, 0}, 3).empty());
+}
+
+// The edge generator before the k-d tree, kept as the reference result. It draws from the same random
+// source in the same order as GraphGenerator::generateEdges for undirected, randomly weighted graphs.
+static std::vector<GraphEdge> legacyEdges(const GraphLayout &layout, Random &random) {
+    const int numNodes = int(layout.positions.size());
+    std::vector<GraphEdge> edges;
+    for (int i = 0; i < numNodes - 1; i++) {
+        edges.push_back(GraphEdge{i, i + 1, random.bounded(1, MaxGeneratedWeight + 1), false});
+    }
+    for (int node1 = 0; node1 < numNodes; node1++) {
+        std::vector<bool> excluded(numNodes, false);
+        excluded[node1] = true;
+        int numExcluded = 1;
+        int node2 = -1;
+        bool edgeExists = false;
+        do {
+            if (numExcluded == numNodes) {
+                return edges;
+            }
+            do {
+                node2 = random.bounded(numNodes);
+            } while (excluded[node2]);
+            double shortestDist = distance(layout.positions[node1], layout.positions[node2]);
+            for (int n = 0; n < numNodes; n++) {
+                double dist = distance(layout.positions[node1], layout.positions[n]);
+                if (!excluded[n] && dist < shortestDist) {
+                    shortestDist = dist;
+                    node2 = n;
+                }
+            }
+            edgeExists = false;
+            for (const GraphEdge &e : edges) {
+                if ((e.source == node1 && e.dest == node2) || (e.source == node2 && e.dest == node1)) {
+                    edgeExists = true;
+                    excluded[node2] = true;
+                    numExcluded++;
+                    break;
+                }
+            }
+        } while (edgeExists);
+        edges.push_back(GraphEdge{node1, node2, random.bounded(1, MaxGeneratedWeight + 1), false});
+    }
+    return edges;
+}
+
+// Test the k-d tree generator produces exactly the edges of the scanning generator for the same seed
+TEST(KdTreeTest, GenerateEdgesMatchesLegacy) {
+    for (int graphType : {0, 1}) {
+        GeneratorConfig config;
+        config.graphType = graphType;
+        for (uint64_t seed = 1; seed <= 200; seed++) {
+            Random random(seed);
+            GraphGenerator generator(config, random);
+            GraphLayout layout = generator.generateNodes(generator.generateColumnCount());
+            Random legacyRandom = random;
+            generator.generateEdges(layout);
+            std::vector<GraphEdge> expected = legacyEdges(layout, legacyRandom);
+
+            ASSERT_EQ(layout.edges.size(), expected.size()) << "seed " << seed;
+            for (size_t i = 0; i < expected.size(); i++) {
+                EXPECT_EQ(layout.edges[i].source, expected[i].source);
+                EXPECT_EQ(layout.edges[i].dest, expected[i].dest);
+                EXPECT_EQ(layout.edges[i].weight, expected[i].weight);
+            }
+        }
+    }
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <functional>
+#include <set>
+#include "kshortestpaths.h"
+#include "question.h"
+#include "random.h"
+
+// Small random graph with no parallel edges and a mix of directed and undirected edges
+static Graph smallGraph(uint64_t seed) {
+    Random random(seed);
+    const int numNodes = 8;
+    std::set<std::pair<int, int>> pairs;
+    std::vector<GraphEdge> edges;
+    for (int i = 0; i < 16; i++) {
+        int a = random.bounded(numNodes);
+        int b = random.bounded(numNodes);
+        if (a != b && pairs.insert({std::min(a, b), std::max(a, b)}).second) {
+            edges.push_back({a, b, random.bounded(1, 6), random.bounded(3) == 0});
+        }
+    }
+    return Graph(std::vector<Point>(numNodes, Point{0, 0}), edges);
+}
+
+// Every simple path found by a plain recursive search
+static std::vector<std::vector<int>> recursivePaths(const Graph &graph, int startNode, int endNode) {
+    std::vector<std::vector<int>> paths;
+    std::vector<int> path;
+    std::vector<bool> visited(graph.nodeCount(), false);
+    std::function<void(int)> visit = [&](int node) {
+        visited[node] = true;
+        path.push_back(node);
+        if (node == endNode) {
+            paths.push_back(path);
+        } else {
+            for (const Arc &arc : graph.outArcs(node)) {
+                if (!visited[arc.node]) {
+                    visit(arc.node);
+                }
+            }
+        }
+        path.pop_back();
+        visited[node] = false;
+    };
+    visit(startNode);
+    return paths;
+}
+
+// Weight of a node path, using the single edge joining each pair of nodes
+static int nodePathWeight(const Graph &graph, const std::vector<int> &nodes) {
+    int weight = 0;
+    for (size_t i = 0; i + 1 < nodes.size(); i++) {
+        weight += graph.edge(graph.findEdge(nodes[i], nodes[i + 1])).weight;
+    }
+    return weight;
+}
+
+// Test the paths come out in weight order and match the weights of every simple path
+TEST(KShortestPathsTest, MatchesAllSimplePaths) {
+    for (uint64_t seed = 1; seed <= 200; seed++) {
+        Graph graph = smallGraph(seed);
+        std::vector<int> expected;
+        for (const std::vector<int> &path : recursivePaths(graph, 0, 7)) {
+            expected.push_back(nodePathWeight(graph, path));
+        }
+        std::sort(expected.begin(), expected.end());
+
+        KShortestPaths paths(graph, 0, 7);
+        std::set<std::vector<int>> seen;
+        for (size_t k = 0; k <= expected.size(); k++) {
+            PathResult path = paths.next();
+            if (k == expected.size()) {
+                EXPECT_EQ(path.distance, Unreachable); // Every path was returned
+                break;
+            }
+            ASSERT_NE(path.distance, Unreachable) << "seed " << seed;
+            EXPECT_EQ(path.distance, expected[k]) << "seed " << seed;
+            EXPECT_TRUE(seen.insert(path.edges).second); // No path twice
+
+            // The path is a connected, loopless walk from the start to the end
+            std::set<int> nodes{0};
+            int node = 0;
+            for (int id : path.edges) {
+                const GraphEdge &e = graph.edge(id);
+                ASSERT_TRUE(e.source == node || (!e.directed && e.dest == node));
+                node = e.source == node ? e.dest : e.source;
+                EXPECT_TRUE(nodes.insert(node).second);
+            }
+            EXPECT_EQ(node, 7);
+        }
+    }
+}
+
+// Test a given first path is returned first, even when another path ties with it
+TEST(KShortestPathsTest, StartsFromGivenPath) {
+    // Two routes of weight 2 from A to D, through B or through C
+    Graph graph({{0, 0}, {1, 0}, {0, 1}, {1, 1}}, {{0, 1, 1, false}, {1, 3, 1, false}, {0, 2, 1, false}, {2, 3, 1, false}});
+    PathResult first;
+    first.edges = {2, 3};
+    first.distance = 2;
+
+    KShortestPaths paths(graph, 0, 3, &first);
+    EXPECT_EQ(paths.next().edges, first.edges);
+    PathResult second = paths.next();
+    EXPECT_EQ(second.edges, (std::vector<int>{0, 1}));
+    EXPECT_EQ(second.distance, 2);
+    EXPECT_EQ(paths.next().distance, Unreachable);
+}
+
+// Test distractors are the next costlier paths, skipping paths that tie with the answer
+TEST(KShortestPathsTest, NearOptimalDistractors) {
+    // A-B-D and A-C-D weigh 2, A-D weighs 5 and A-B-C-D weighs 4
+    Graph graph({{0, 0}, {1, 0}, {0, 1}, {1, 1}},
+                {{0, 1, 1, false}, {1, 3, 1, false}, {0, 2, 1, false}, {2, 3, 1, false}, {0, 3, 5, false}, {1, 2, 2, false}});
+    PathResult answer = shortestPath(graph, 0, 3, SolverMode::Dijkstra);
+    ASSERT_EQ(answer.distance, 2);
+
+    std::vector<std::string> distractors = nearOptimalPaths(graph, answer, 0, 3, 2);
+    EXPECT_EQ(distractors, (std::vector<std::string>{"ABCD", "ACBD"}));
+
+    distractors = nearOptimalPaths(graph, answer, 0, 3, 4);
+    EXPECT_EQ(distractors.size(), 3u); // Only three paths are longer than the answer
+    EXPECT_EQ(distractors.back(), "AD");
+}
@@ -12,8 +12,8 @@ class NodeTest : public ::testing::Test {
 protected:
     void SetUp() override {
         // Initialize common objects before each test
-        nodeA = new Node('A', 0);
-        nodeB = new Node('B', 1);
+        nodeA = new Node(0, 0);
+        nodeB = new Node(1, 1);
     }
 
     void TearDown() override {
@@ -29,13 +29,22 @@ protected:
 
 // Test constructor and getters
 TEST_F(NodeTest, ConstructorAndGetters) {
-    ASSERT_EQ(nodeA->getName(), 'A');
+    ASSERT_EQ(nodeA->getName(), "A");
     ASSERT_EQ(nodeA->getCol(), 0);
 
-    ASSERT_EQ(nodeB->getName(), 'B');
+    ASSERT_EQ(nodeB->getName(), "B");
     ASSERT_EQ(nodeB->getCol(), 1);
 }
 
+// Test labels are formatted from the id, past the single letters
+TEST(NodeLabelTest, LargeGraphLabels) {
+    EXPECT_EQ(Node(25, 0).getName(), "Z");
+    EXPECT_EQ(Node(26, 0).getName(), "AA");
+    EXPECT_EQ(Node(10000, 0).getName(), "NTQ");
+    EXPECT_EQ(Node(10000, 0, LabelStyle::Numbers).getName(), "10000");
+    EXPECT_EQ(Node(7, 0).getId(), 7);
+}
+
 // Test node colour setter
 TEST_F(NodeTest, SetNodeColour) {
     nodeA->setNodeColour(Qt::red);
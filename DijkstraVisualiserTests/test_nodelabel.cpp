@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+#include "nodelabel.h"
+#include "question.h"
+
+// Test letter labels count like spreadsheet columns
+TEST(NodeLabelTest, Letters) {
+    EXPECT_EQ(nodeLabel(0), "A");
+    EXPECT_EQ(nodeLabel(25), "Z");
+    EXPECT_EQ(nodeLabel(26), "AA");
+    EXPECT_EQ(nodeLabel(51), "AZ");
+    EXPECT_EQ(nodeLabel(52), "BA");
+    EXPECT_EQ(nodeLabel(701), "ZZ");
+    EXPECT_EQ(nodeLabel(702), "AAA");
+}
+
+// Test numeric labels are the node id
+TEST(NodeLabelTest, Numbers) {
+    EXPECT_EQ(nodeLabel(0, LabelStyle::Numbers), "0");
+    EXPECT_EQ(nodeLabel(12345, LabelStyle::Numbers), "12345");
+
+    std::string label = "x";
+    appendNodeLabel(label, 42, LabelStyle::Numbers);
+    EXPECT_EQ(label, "x42");
+}
+
+// Test paths keep the run-together letters for small graphs and gain separators beyond them
+TEST(NodeLabelTest, PathSeparators) {
+    EXPECT_STREQ(labelSeparator(26), "");
+    EXPECT_STREQ(labelSeparator(27), "-");
+    EXPECT_STREQ(labelSeparator(5, LabelStyle::Numbers), "-");
+
+    // Chain 0 - 1 - ... - 29 with a shortcut 0 - 28
+    std::vector<Point> positions(30, Point{0, 0});
+    std::vector<GraphEdge> edges;
+    for (int i = 0; i < 29; i++) {
+        edges.push_back({i, i + 1, 1, false});
+    }
+    edges.push_back({0, 28, 1, false});
+    Graph graph(positions, edges);
+
+    EXPECT_EQ(pathLabel(graph, 0, {29, 28}), "A-AC-AD");
+    EXPECT_EQ(pathLabel(graph, 0, {29, 28}, LabelStyle::Numbers), "0-28-29");
+}
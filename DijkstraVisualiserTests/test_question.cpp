@@ -0,0 +1,321 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <set>
+#include "kshortestpaths.h"
+#include "question.h"
+#include "workstealingpool.h"
+
+// Test the pipeline produces a solvable question with a consistent answer
+TEST(QuestionPipelineTest, GeneratesValidQuestion) {
+    for (int graphType : {0, 1}) {
+        GeneratorConfig config;
+        config.graphType = graphType;
+        config.directed = true;
+        QuestionPipeline pipeline(config, SolverMode::Dijkstra);
+
+        for (uint64_t seed = 1; seed <= 20; seed++) {
+            StageTimings timings;
+            Question question = pipeline.generate(seed, &timings);
+            EXPECT_EQ(question.attempts, 1);
+            EXPECT_GE(question.path.edges.size(), 2u);
+            EXPECT_EQ(question.startNode, 0);
+            EXPECT_EQ(question.endNode, question.graph.nodeCount() - 1);
+            EXPECT_EQ(question.answer.size(), question.path.edges.size() + 1);
+            EXPECT_EQ(question.answer.front(), 'A');
+            EXPECT_EQ(question.answer.back(), nodeLabel(question.endNode).front());
+            EXPECT_GT(timings.generate, 0);
+
+            // Distractors are distinct paths between the same nodes, other than the answer
+            EXPECT_LE(question.distractors.size(), size_t(DistractorCount));
+            for (const std::string &distractor : question.distractors) {
+                EXPECT_NE(distractor, question.answer);
+                EXPECT_EQ(distractor.front(), question.answer.front());
+                EXPECT_EQ(distractor.back(), question.answer.back());
+                EXPECT_EQ(std::count(question.distractors.begin(), question.distractors.end(), distractor), 1);
+            }
+        }
+    }
+}
+
+// Test every question has an answer of at least two edges from its first and only graph
+TEST(QuestionPipelineTest, ConnectedByConstruction) {
+    for (int graphType : {0, 1}) {
+        for (bool directed : {false, true}) {
+            GeneratorConfig config;
+            config.graphType = graphType;
+            config.directed = directed;
+            QuestionPipeline pipeline(config, SolverMode::Dijkstra);
+            for (uint64_t seed = 1; seed <= 300; seed++) {
+                const Question question = pipeline.generate(seed);
+                ASSERT_EQ(question.attempts, 1);
+                ASSERT_NE(question.path.distance, Unreachable) << seed;
+                ASSERT_GE(question.path.edges.size(), 2u) << seed;
+            }
+        }
+    }
+}
+
+// Test tied shortest paths are counted and listed as correct, and that unique answers can be asked for
+TEST(QuestionPipelineTest, TiedShortestPaths) {
+    GeneratorConfig config;
+    int ambiguous = 0;
+    for (uint64_t seed = 1; seed <= 200; seed++) {
+        const Question question = QuestionPipeline(config, SolverMode::Dijkstra).generate(seed);
+        ASSERT_GE(question.optimalPaths, 1);
+        ASSERT_FALSE(question.optimalAnswers.empty());
+        EXPECT_EQ(question.optimalAnswers.front(), question.answer);
+        EXPECT_LE(int(question.optimalAnswers.size()), std::min(question.optimalPaths, MaxTiedAnswers));
+        ambiguous += question.optimalPaths > 1;
+
+        // No distractor is another correct answer
+        for (const std::string &distractor : question.distractors) {
+            EXPECT_EQ(std::count(question.optimalAnswers.begin(), question.optimalAnswers.end(), distractor), 0);
+        }
+    }
+    EXPECT_GT(ambiguous, 0);
+
+    // The other solvers skip the tree, and find the same ties through the distractor search
+    for (SolverMode mode : {SolverMode::Bidirectional, SolverMode::AStar}) {
+        for (uint64_t seed = 1; seed <= 50; seed++) {
+            const Question counted = QuestionPipeline(config, SolverMode::Dijkstra).generate(seed);
+            const Question question = QuestionPipeline(config, mode).generate(seed);
+            EXPECT_TRUE(question.tree.predecessorEdge.empty()) << seed;
+            EXPECT_EQ(question.path.distance, counted.path.distance) << seed;
+            if (counted.optimalPaths < MaxTiedAnswers) {
+                std::vector<std::string> answers = question.optimalAnswers;
+                std::vector<std::string> countedAnswers = counted.optimalAnswers;
+                std::sort(answers.begin(), answers.end());
+                std::sort(countedAnswers.begin(), countedAnswers.end());
+                EXPECT_EQ(question.optimalPaths, counted.optimalPaths) << seed;
+                EXPECT_EQ(answers, countedAnswers) << seed;
+            }
+        }
+    }
+
+    // When a unique answer is asked for, the tree is grown and leads along whichever answer the solver picked
+    config.uniqueAnswers = true;
+    for (SolverMode mode : {SolverMode::Dijkstra, SolverMode::Bidirectional, SolverMode::AStar}) {
+        for (uint64_t seed = 1; seed <= 50; seed++) {
+            const Question question = QuestionPipeline(config, mode).generate(seed);
+            EXPECT_EQ(pathEdges(question.tree, question.endNode), question.path.edges) << seed;
+        }
+    }
+
+    for (uint64_t seed = 1; seed <= 200; seed++) {
+        const Question question = QuestionPipeline(config, SolverMode::Bidirectional).generate(seed);
+        ASSERT_TRUE(question.optimalPaths == 1 || question.attempts == MaxUniqueAttempts) << seed;
+        if (question.optimalPaths == 1) {
+            EXPECT_EQ(question.optimalAnswers, std::vector<std::string>{question.answer});
+        }
+    }
+}
+
+// Test distance questions ask for the length of the same path, offering other lengths as distractors
+TEST(QuestionPipelineTest, DistanceMode) {
+    GeneratorConfig config;
+    config.directed = true;
+    GeneratorConfig distanceConfig = config;
+    distanceConfig.quizMode = QuizMode::Distance;
+
+    for (uint64_t seed = 1; seed <= 20; seed++) {
+        Question pathQuestion = QuestionPipeline(config, SolverMode::Dijkstra).generate(seed);
+        Question question = QuestionPipeline(distanceConfig, SolverMode::Dijkstra).generate(seed);
+        EXPECT_EQ(question.path.edges, pathQuestion.path.edges);
+        EXPECT_EQ(question.answer, std::to_string(question.path.distance));
+        EXPECT_EQ(question.kind, QuizMode::Distance);
+        EXPECT_EQ(pathQuestion.kind, QuizMode::ShortestPath);
+
+        // Always a full set of distinct positive lengths other than the answer
+        ASSERT_EQ(question.distractors.size(), size_t(DistractorCount));
+        for (const std::string &distractor : question.distractors) {
+            EXPECT_NE(distractor, question.answer);
+            EXPECT_GT(std::stoi(distractor), 0);
+            EXPECT_EQ(std::count(question.distractors.begin(), question.distractors.end(), distractor), 1);
+        }
+        EXPECT_EQ(question.choices[question.answerChoice], question.answer);
+    }
+}
+
+// Test a multi-destination question asks about further nodes of the same graph, each answer matching
+// a fresh search, while its first question stays the path question of the same seed
+TEST(QuestionPipelineTest, MultiDestinationMode) {
+    GeneratorConfig config;
+    config.graphType = 1;
+    config.directed = true;
+    GeneratorConfig multiConfig = config;
+    multiConfig.quizMode = QuizMode::MultiDestination;
+
+    for (uint64_t seed = 1; seed <= 20; seed++) {
+        Question pathQuestion = QuestionPipeline(config, SolverMode::Dijkstra).generate(seed);
+        Question question = QuestionPipeline(multiConfig, SolverMode::Dijkstra).generate(seed);
+        EXPECT_EQ(question.answer, pathQuestion.answer);
+        EXPECT_EQ(question.choices, pathQuestion.choices);
+        EXPECT_TRUE(pathQuestion.destinations.empty());
+
+        ASSERT_LE(question.destinations.size(), size_t(DestinationsPerGraph - 1));
+        EXPECT_FALSE(question.destinations.empty());
+        const SearchResult fresh = dijkstra(question.graph, question.startNode);
+        std::set<int> asked{question.startNode, question.endNode};
+        for (size_t i = 0; i < question.destinations.size(); i++) {
+            const Destination &destination = question.destinations[i];
+            EXPECT_TRUE(asked.insert(destination.endNode).second);
+            EXPECT_EQ(destination.kind, i % 2 == 0 ? QuizMode::Distance : QuizMode::ShortestPath);
+            EXPECT_EQ(destination.path.distance, fresh.distance[destination.endNode]);
+            EXPECT_EQ(destination.path.edges, pathEdges(question.tree, destination.endNode));
+            EXPECT_GE(destination.path.edges.size(), 2u);
+            EXPECT_EQ(destination.answer, destination.kind == QuizMode::Distance
+                                              ? std::to_string(destination.path.distance)
+                                              : pathLabel(question.graph, question.startNode, destination.path.edges,
+                                                          question.labelStyle));
+            EXPECT_EQ(destination.choices[destination.answerChoice], destination.answer);
+            for (const std::string &distractor : destination.distractors) {
+                EXPECT_EQ(std::count(destination.optimalAnswers.begin(), destination.optimalAnswers.end(), distractor), 0);
+            }
+        }
+    }
+}
+
+// Test the sidetracks read off a tree are loopless paths to the node, shortest first and never shorter
+// than the answer, and start at the next shortest length whenever that path leaves the answer only once
+TEST(QuestionPipelineTest, SidetrackPaths) {
+    GeneratorConfig config;
+    config.graphType = 1;
+    config.directed = true;
+    int matched = 0;
+    for (uint64_t seed = 1; seed <= 30; seed++) {
+        const Question question = QuestionPipeline(config, SolverMode::Dijkstra).generate(seed);
+        const std::vector<PathResult> paths = sidetrackPaths(question.graph, question.tree, question.endNode);
+        ASSERT_FALSE(paths.empty()) << seed;
+        int previous = question.path.distance;
+        for (const PathResult &path : paths) {
+            EXPECT_GE(path.distance, previous) << seed;
+            previous = path.distance;
+            EXPECT_NE(path.edges, question.path.edges) << seed;
+
+            int node = question.startNode;
+            int distance = 0;
+            std::set<int> visited{node};
+            for (int id : path.edges) {
+                const GraphEdge &e = question.graph.edge(id);
+                ASSERT_TRUE(e.source == node || (!e.directed && e.dest == node)) << seed;
+                node = e.source == node ? e.dest : e.source;
+                distance += e.weight;
+                EXPECT_TRUE(visited.insert(node).second) << seed;
+            }
+            EXPECT_EQ(node, question.endNode);
+            EXPECT_EQ(distance, path.distance);
+        }
+
+        KShortestPaths next(question.graph, question.startNode, question.endNode, &question.path);
+        next.next();
+        PathResult longer = next.next();
+        while (longer.distance == question.path.distance) {
+            longer = next.next();
+        }
+        const auto firstLonger = std::find_if(paths.begin(), paths.end(), [&](const PathResult &path) {
+            return path.distance > question.path.distance;
+        });
+        if (firstLonger != paths.end()) {
+            EXPECT_GE(firstLonger->distance, longer.distance) << seed;
+            matched += firstLonger->distance == longer.distance;
+        }
+    }
+    EXPECT_GT(matched, 20);
+}
+
+// Test the same seed always generates the same question
+TEST(QuestionPipelineTest, SeedsAreDeterministic) {
+    QuestionPipeline pipeline(GeneratorConfig(), SolverMode::Bidirectional);
+    for (uint64_t seed = 100; seed < 110; seed++) {
+        Question a = pipeline.generate(seed);
+        Question b = pipeline.generate(seed);
+        EXPECT_EQ(a.answer, b.answer);
+        EXPECT_EQ(a.distractors, b.distractors);
+        EXPECT_EQ(a.choices, b.choices);
+        EXPECT_EQ(a.answerChoice, b.answerChoice);
+        ASSERT_EQ(a.graph.nodeCount(), b.graph.nodeCount());
+        ASSERT_EQ(a.graph.edgeCount(), b.graph.edgeCount());
+        for (int i = 0; i < a.graph.nodeCount(); i++) {
+            EXPECT_EQ(a.graph.position(i).x, b.graph.position(i).x);
+            EXPECT_EQ(a.graph.position(i).y, b.graph.position(i).y);
+        }
+    }
+}
+
+// Test the choices offer the answer once next to every distractor, with the answer in any position
+TEST(QuestionPipelineTest, ShufflesChoices) {
+    GeneratorConfig config;
+    config.graphType = 1;
+    QuestionPipeline pipeline(config, SolverMode::Dijkstra);
+    std::set<int> answerPositions;
+    for (uint64_t seed = 1; seed <= 100; seed++) {
+        Question question = pipeline.generate(seed);
+        ASSERT_EQ(question.choices.size(), question.distractors.size() + 1);
+        ASSERT_GE(question.answerChoice, 0);
+        ASSERT_LT(question.answerChoice, int(question.choices.size()));
+        EXPECT_EQ(question.choices[question.answerChoice], question.answer);
+
+        std::vector<std::string> expected = question.distractors;
+        expected.push_back(question.answer);
+        std::vector<std::string> offered = question.choices;
+        std::sort(expected.begin(), expected.end());
+        std::sort(offered.begin(), offered.end());
+        EXPECT_EQ(offered, expected);
+
+        if (question.distractors.size() == size_t(DistractorCount)) {
+            answerPositions.insert(question.answerChoice);
+        }
+    }
+    EXPECT_EQ(answerPositions.size(), size_t(DistractorCount + 1)); // Including the last position
+}
+
+// Test large graph mode works end to end beyond the single letter labels
+TEST(QuestionPipelineTest, LargeGraphMode) {
+    GeneratorConfig config;
+    config.graphType = 2;
+    config.sceneWidth = 4000;
+    config.sceneHeight = 2400;
+    Question question = QuestionPipeline(config, SolverMode::Dijkstra).generate(3);
+    EXPECT_GT(question.graph.nodeCount(), SingleLetterLabels);
+    EXPECT_EQ(question.answer.substr(0, 2), "A-");
+    EXPECT_EQ(std::count(question.answer.begin(), question.answer.end(), '-'), int(question.path.edges.size()));
+    EXPECT_LE(question.distractors.size(), size_t(DistractorCount));
+    for (const std::string &distractor : question.distractors) {
+        EXPECT_EQ(distractor.substr(0, 2), "A-");
+    }
+
+    // Stages scale to ten thousand nodes
+    config.sceneWidth = 90000;
+    Random random(1);
+    GraphGenerator generator(config, random);
+    GraphLayout layout = generator.generateNodes(1200);
+    ASSERT_GT(layout.positions.size(), 10000u);
+    generator.generateEdges(layout);
+    generator.removeEdgesWithHighIntersections(layout);
+    generator.removeNodeIntersectingEdges(layout);
+    Graph graph(std::move(layout.positions), std::move(layout.edges));
+    PathResult path = shortestPath(graph, 0, graph.nodeCount() - 1, SolverMode::Dijkstra);
+    if (!path.edges.empty()) {
+        std::string answer = pathLabel(graph, 0, path.edges);
+        EXPECT_EQ(std::count(answer.begin(), answer.end(), '-'), int(path.edges.size()));
+    }
+}
+
+// Test the pool runs every index exactly once, across repeated loops
+TEST(WorkStealingPoolTest, RunsEveryIndexOnce) {
+    WorkStealingPool pool(4);
+    EXPECT_EQ(pool.threadCount(), 4);
+    for (int round = 0; round < 50; round++) {
+        std::vector<std::atomic<int>> hits(1000);
+        pool.parallelFor(0, 1000, [&](int index, int worker) {
+            EXPECT_GE(worker, 0);
+            EXPECT_LT(worker, 4);
+            hits[index]++;
+        });
+        for (const std::atomic<int> &hit : hits) {
+            ASSERT_EQ(hit.load(), 1);
+        }
+    }
+    pool.parallelFor(5, 5, [](int, int) { FAIL(); });
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "questionbank.h"
+
+// Test fixture that writes a bank of generated questions and reads the file back into memory
+class QuestionBankTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        config.graphType = 1;
+        config.directed = true;
+        QuestionPipeline pipeline(config, SolverMode::Dijkstra);
+        QuestionBankWriter writer(fileName);
+        ASSERT_TRUE(writer.isOpen());
+        for (uint64_t seed = 1; seed <= 20; seed++) {
+            questions.push_back(pipeline.generate(seed));
+            ASSERT_TRUE(writer.add(questions.back(), config));
+        }
+        ASSERT_TRUE(writer.finish());
+
+        std::ifstream in(fileName, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    void TearDown() override {
+        std::remove(fileName.c_str());
+    }
+
+    const std::string fileName = ::testing::TempDir() + "questionbank_test.dqb";
+    GeneratorConfig config;
+    std::vector<Question> questions;
+    std::vector<unsigned char> bytes;
+};
+
+// Test every question comes back from its record as it was written
+TEST_F(QuestionBankTest, RoundTripsQuestions) {
+    QuestionBankView bank(bytes.data(), bytes.size());
+    ASSERT_TRUE(bank.isValid());
+    ASSERT_EQ(bank.questionCount(), int(questions.size()));
+
+    // Read in reverse, as any question can be found without reading the ones before it
+    for (int n = bank.questionCount() - 1; n >= 0; n--) {
+        const Question &expected = questions[n];
+        Question loaded = bank.question(n);
+        EXPECT_EQ(loaded.seed, expected.seed);
+        EXPECT_EQ(loaded.startNode, expected.startNode);
+        EXPECT_EQ(loaded.endNode, expected.endNode);
+        EXPECT_EQ(loaded.path.edges, expected.path.edges);
+        EXPECT_EQ(loaded.path.distance, expected.path.distance);
+        EXPECT_EQ(loaded.answer, expected.answer);
+        EXPECT_EQ(loaded.choices, expected.choices);
+        EXPECT_EQ(loaded.answerChoice, expected.answerChoice);
+        EXPECT_EQ(loaded.kind, expected.kind);
+        EXPECT_EQ(loaded.distractors.size(), expected.distractors.size());
+        EXPECT_EQ(loaded.columns, expected.columns);
+
+        ASSERT_EQ(loaded.graph.nodeCount(), expected.graph.nodeCount());
+        for (int i = 0; i < loaded.graph.nodeCount(); i++) {
+            EXPECT_EQ(loaded.graph.position(i).x, float(expected.graph.position(i).x)); // Stored as floats
+            EXPECT_EQ(loaded.graph.position(i).y, float(expected.graph.position(i).y));
+        }
+        ASSERT_EQ(loaded.graph.edgeCount(), expected.graph.edgeCount());
+        for (int i = 0; i < loaded.graph.edgeCount(); i++) {
+            EXPECT_EQ(loaded.graph.edge(i).source, expected.graph.edge(i).source);
+            EXPECT_EQ(loaded.graph.edge(i).dest, expected.graph.edge(i).dest);
+            EXPECT_EQ(loaded.graph.edge(i).weight, expected.graph.edge(i).weight);
+            EXPECT_EQ(loaded.graph.edge(i).directed, expected.graph.edge(i).directed);
+        }
+
+        // The raw record is readable in place, without hydrating the question
+        BankRecord record = bank.record(n);
+        ASSERT_TRUE(record.isValid());
+        EXPECT_EQ(record.header->sceneWidth, float(config.sceneWidth));
+        EXPECT_EQ(record.choice(expected.answerChoice), expected.answer);
+    }
+}
+
+// Test damaged banks are rejected rather than read past their end
+TEST_F(QuestionBankTest, RejectsDamagedBanks) {
+    EXPECT_FALSE(QuestionBankView(nullptr, 0).isValid());
+    EXPECT_FALSE(QuestionBankView(bytes.data(), 10).isValid()); // Shorter than the header
+
+    std::vector<unsigned char> badMagic = bytes;
+    badMagic[0] = 'X';
+    EXPECT_FALSE(QuestionBankView(badMagic.data(), badMagic.size()).isValid());
+
+    QuestionBankView bank(bytes.data(), bytes.size());
+    EXPECT_FALSE(bank.record(-1).isValid());
+    EXPECT_FALSE(bank.record(bank.questionCount()).isValid());
+    EXPECT_EQ(bank.question(bank.questionCount()).graph.nodeCount(), 0);
+
+    // A truncated bank whose header points the index into record data reads garbage offsets
+    std::vector<unsigned char> truncated(bytes.begin(), bytes.end() - 8 * questions.size() - 8);
+    BankHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    header.indexOffset = truncated.size() - 8 * questions.size();
+    header.indexOffset -= header.indexOffset % 8;
+    std::memcpy(truncated.data(), &header, sizeof(header));
+    QuestionBankView damaged(truncated.data(), truncated.size());
+    ASSERT_TRUE(damaged.isValid());
+    for (int n = 0; n < damaged.questionCount(); n++) {
+        damaged.question(n); // Garbage offsets must not crash
+    }
+}
+
+// Test a distance question comes back as one, so it is asked for its length whatever mode is selected
+TEST_F(QuestionBankTest, KeepsQuestionKind) {
+    GeneratorConfig distanceConfig = config;
+    distanceConfig.quizMode = QuizMode::Distance;
+    const Question distance = QuestionPipeline(distanceConfig, SolverMode::Dijkstra).generate(5);
+    ASSERT_EQ(distance.kind, QuizMode::Distance);
+    {
+        QuestionBankWriter writer(fileName);
+        ASSERT_TRUE(writer.add(questions.front(), config));
+        ASSERT_TRUE(writer.add(distance, distanceConfig));
+    }
+    std::ifstream in(fileName, std::ios::binary);
+    std::vector<unsigned char> mixed{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    QuestionBankView bank(mixed.data(), mixed.size());
+    ASSERT_EQ(bank.questionCount(), 2);
+    EXPECT_EQ(bank.question(0).kind, QuizMode::ShortestPath);
+    EXPECT_EQ(bank.question(1).kind, QuizMode::Distance);
+    EXPECT_EQ(bank.question(1).answer, std::to_string(distance.path.distance));
+}
+
+// Test a writer that is never finished explicitly still leaves a complete bank
+TEST_F(QuestionBankTest, DestructorFinishes) {
+    {
+        QuestionBankWriter writer(fileName);
+        ASSERT_TRUE(writer.add(questions.front(), config));
+    }
+    std::ifstream in(fileName, std::ios::binary);
+    std::vector<unsigned char> single{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    QuestionBankView bank(single.data(), single.size());
+    ASSERT_TRUE(bank.isValid());
+    ASSERT_EQ(bank.questionCount(), 1);
+    EXPECT_EQ(bank.question(0).answer, questions.front().answer);
+}
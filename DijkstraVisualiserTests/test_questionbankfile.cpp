@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include "questionbankfile.h"
+
+// Test a question read from a mapped bank matches the question it was written from
+TEST(QuestionBankFileTest, ReadsMappedQuestion) {
+    const std::string fileName = ::testing::TempDir() + "questionbankfile_test.dqb";
+    GeneratorConfig config;
+    config.directed = true;
+    Question question = QuestionPipeline(config, SolverMode::Dijkstra).generate(5);
+    {
+        QuestionBankWriter writer(fileName);
+        ASSERT_TRUE(writer.add(question, config));
+    }
+
+    QuestionBankFile bank;
+    ASSERT_TRUE(bank.open(QString::fromStdString(fileName)));
+    ASSERT_EQ(bank.count(), 1);
+    EXPECT_EQ(bank.sceneRect(0), QRectF(0, 0, config.sceneWidth, config.sceneHeight));
+
+    const Question read = bank.question(0);
+    EXPECT_EQ(read.seed, question.seed);
+    EXPECT_EQ(read.columns, question.columns);
+    ASSERT_EQ(read.graph.nodeCount(), question.graph.nodeCount());
+    for (int i = 0; i < read.graph.nodeCount(); i++) {
+        EXPECT_FLOAT_EQ(read.graph.position(i).x, question.graph.position(i).x);
+        EXPECT_FLOAT_EQ(read.graph.position(i).y, question.graph.position(i).y);
+    }
+    ASSERT_EQ(read.graph.edgeCount(), question.graph.edgeCount());
+    for (int id = 0; id < read.graph.edgeCount(); id++) {
+        EXPECT_EQ(read.graph.edge(id).source, question.graph.edge(id).source);
+        EXPECT_EQ(read.graph.edge(id).dest, question.graph.edge(id).dest);
+        EXPECT_EQ(read.graph.edge(id).weight, question.graph.edge(id).weight);
+        EXPECT_EQ(read.graph.edge(id).directed, question.graph.edge(id).directed);
+    }
+    EXPECT_EQ(read.path.edges, question.path.edges);
+    EXPECT_EQ(read.choices, question.choices);
+
+    bank.close();
+    EXPECT_FALSE(bank.isOpen());
+    std::remove(fileName.c_str());
+
+    // Files that are not banks are refused
+    EXPECT_FALSE(bank.open(QString::fromStdString(fileName)));
+}
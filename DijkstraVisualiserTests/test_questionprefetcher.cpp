@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <QElapsedTimer>
+#include <QThread>
+#include "questionprefetcher.h"
+
+// Waits up to a few seconds for the worker to fill a queue
+static bool waitForReady(QuestionPrefetcher &prefetcher, const GeneratorConfig &config, SolverMode mode, int count) {
+    QElapsedTimer timer;
+    timer.start();
+    while (prefetcher.readyCount(config, mode) < count) {
+        if (timer.elapsed() > 10000) {
+            return false;
+        }
+        QThread::msleep(5);
+    }
+    return true;
+}
+
+// Test an empty queue still hands out a valid question
+TEST(QuestionPrefetcherTest, TakeFallsBackToGenerating) {
+    QuestionPrefetcher prefetcher(2);
+    GeneratorConfig config;
+    Question question = prefetcher.take(config, SolverMode::Dijkstra);
+    EXPECT_GE(question.path.edges.size(), 2u);
+    EXPECT_EQ(question.endNode, question.graph.nodeCount() - 1);
+}
+
+// Test the worker fills the active queue up to its depth and refills it after a take
+TEST(QuestionPrefetcherTest, FillsActiveQueue) {
+    QuestionPrefetcher prefetcher(3);
+    GeneratorConfig config;
+    prefetcher.setActive(config, SolverMode::Dijkstra);
+    ASSERT_TRUE(waitForReady(prefetcher, config, SolverMode::Dijkstra, 3));
+
+    QThread::msleep(50);
+    EXPECT_EQ(prefetcher.readyCount(config, SolverMode::Dijkstra), 3); // Never fills past its depth
+
+    Question question = prefetcher.take(config, SolverMode::Dijkstra);
+    EXPECT_GE(question.path.edges.size(), 2u);
+    EXPECT_TRUE(waitForReady(prefetcher, config, SolverMode::Dijkstra, 3));
+}
+
+// Test each configuration keeps its own queue
+TEST(QuestionPrefetcherTest, SeparateQueuePerConfiguration) {
+    QuestionPrefetcher prefetcher(2);
+    GeneratorConfig basic;
+    GeneratorConfig directed;
+    directed.directed = true;
+
+    prefetcher.setActive(basic, SolverMode::Dijkstra);
+    ASSERT_TRUE(waitForReady(prefetcher, basic, SolverMode::Dijkstra, 2));
+    EXPECT_EQ(prefetcher.readyCount(directed, SolverMode::Dijkstra), 0);
+    EXPECT_EQ(prefetcher.readyCount(basic, SolverMode::AStar), 0);
+    GeneratorConfig distance;
+    distance.quizMode = QuizMode::Distance;
+    EXPECT_EQ(prefetcher.readyCount(distance, SolverMode::Dijkstra), 0);
+
+    // Switching configuration keeps the questions already prepared for the old one
+    prefetcher.setActive(directed, SolverMode::Dijkstra);
+    ASSERT_TRUE(waitForReady(prefetcher, directed, SolverMode::Dijkstra, 2));
+    EXPECT_EQ(prefetcher.readyCount(basic, SolverMode::Dijkstra), 2);
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <set>
+#include "random.h"
+#include "segmentgrid.h"
+
+// Random segments in a scene sized area, some of them spanning most of it
+static std::vector<Segment> randomSegments(int count, Random &random) {
+    std::vector<Segment> segments;
+    for (int i = 0; i < count; i++) {
+        segments.push_back(Segment{Point{random.bounded(7710) / 10.0, random.bounded(6000) / 10.0},
+                                   Point{random.bounded(7710) / 10.0, random.bounded(6000) / 10.0}});
+    }
+    return segments;
+}
+
+// Test a rectangle query reports every segment crossing the rectangle, wherever its ends are
+TEST(SegmentGridTest, RectQueryFindsAllCrossingSegments) {
+    Random random(5);
+    for (int trial = 0; trial < 20; trial++) {
+        std::vector<Segment> segments = randomSegments(200, random);
+        SegmentGrid grid(segments, 40.0);
+        ASSERT_EQ(grid.segmentCount(), 200);
+
+        for (int query = 0; query < 20; query++) {
+            const Point topLeft{random.bounded(7000) / 10.0, random.bounded(5500) / 10.0};
+            const Point bottomRight{topLeft.x + random.bounded(1, 800) / 10.0, topLeft.y + random.bounded(1, 500) / 10.0};
+            std::set<int> visited;
+            grid.forEachInRect(topLeft, bottomRight, [&](int id) {
+                visited.insert(id);
+                return true;
+            });
+            for (int id = 0; id < 200; id++) {
+                if (segmentIntersectsRect(segments[id], topLeft, bottomRight)) {
+                    EXPECT_EQ(visited.count(id), 1u) << trial << " " << query << " " << id;
+                }
+            }
+        }
+    }
+}
+
+// Test a query stops as soon as the visitor asks it to
+TEST(SegmentGridTest, RectQueryStopsEarly) {
+    Random random(6);
+    SegmentGrid grid(randomSegments(100, random), 40.0);
+    int visits = 0;
+    grid.forEachInRect(Point{0, 0}, Point{800, 600}, [&](int) { return ++visits < 3; });
+    EXPECT_EQ(visits, 3);
+}
+
+// Test the exact check against a rectangle, for segments inside, crossing, touching and missing it
+TEST(SegmentGridTest, SegmentRectIntersection) {
+    const Point topLeft{0, 0};
+    const Point bottomRight{10, 10};
+    EXPECT_TRUE(segmentIntersectsRect(Segment{{2, 2}, {3, 3}}, topLeft, bottomRight));
+    EXPECT_TRUE(segmentIntersectsRect(Segment{{-5, 5}, {15, 5}}, topLeft, bottomRight));
+    EXPECT_TRUE(segmentIntersectsRect(Segment{{-5, -5}, {15, 15}}, topLeft, bottomRight));
+    EXPECT_TRUE(segmentIntersectsRect(Segment{{10, -5}, {10, 15}}, topLeft, bottomRight));
+    EXPECT_TRUE(segmentIntersectsRect(Segment{{5, 5}, {5, 5}}, topLeft, bottomRight));
+    EXPECT_FALSE(segmentIntersectsRect(Segment{{-5, 12}, {15, 12}}, topLeft, bottomRight));
+    EXPECT_FALSE(segmentIntersectsRect(Segment{{-5, 8}, {8, 21}}, topLeft, bottomRight));
+    EXPECT_FALSE(segmentIntersectsRect(Segment{{11, 11}, {11, 11}}, topLeft, bottomRight));
+}
@@ -0,0 +1,316 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <set>
+#include "bucketqueue.h"
+#include "shortestpath.h"
+
+// Builds a random connected graph with a mix of directed and undirected edges
+static Graph randomGraph(int numNodes, int extraEdges, int maxWeight, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> node(0, numNodes - 1);
+    std::uniform_int_distribution<int> weight(1, maxWeight);
+    std::bernoulli_distribution directed(0.4);
+
+    std::vector<Point> positions(numNodes);
+    std::vector<GraphEdge> edges;
+    for (int i = 0; i + 1 < numNodes; i++) {
+        edges.push_back({i, i + 1, weight(rng), false});
+    }
+    for (int i = 0; i < extraEdges; i++) {
+        int a = node(rng);
+        int b = node(rng);
+        if (a != b) {
+            edges.push_back({a, b, weight(rng), directed(rng)});
+        }
+    }
+    return Graph(positions, edges);
+}
+
+// Test the bucket queue pops keys in order and honours updates
+TEST(DialQueueTest, PopsInKeyOrder) {
+    DialQueue<MaxGeneratedWeight> queue;
+    queue.reset(4);
+    queue.push(0, 0);
+    ASSERT_EQ(queue.pop(), std::make_pair(0, 0));
+    queue.push(1, 9);
+    queue.push(2, 14);
+    queue.push(3, 12);
+    queue.update(2, 14, 5);
+    ASSERT_EQ(queue.pop(), std::make_pair(2, 5));
+    ASSERT_EQ(queue.pop(), std::make_pair(1, 9));
+    ASSERT_EQ(queue.pop(), std::make_pair(3, 12));
+    ASSERT_TRUE(queue.empty());
+}
+
+// Test the radix heap pops monotone keys in order
+TEST(RadixHeapTest, PopsInKeyOrder) {
+    RadixHeap heap;
+    heap.reset();
+    heap.push(0, 1000000);
+    heap.push(1, 3);
+    heap.push(2, 70000);
+    ASSERT_EQ(heap.pop(), std::make_pair(1, 3));
+    heap.push(3, 40);
+    ASSERT_EQ(heap.pop(), std::make_pair(3, 40));
+    ASSERT_EQ(heap.pop(), std::make_pair(2, 70000));
+    ASSERT_EQ(heap.pop(), std::make_pair(0, 1000000));
+    ASSERT_TRUE(heap.empty());
+}
+
+// Test both engines agree on distances, and that reused engines give the same answer twice
+TEST(DijkstraEngineTest, BucketAndRadixAgree) {
+    DijkstraEngine<MaxGeneratedWeight> bucketEngine;
+    DijkstraEngine<> radixEngine;
+    for (unsigned seed = 1; seed <= 20; seed++) {
+        Graph graph = randomGraph(200, 600, MaxGeneratedWeight, seed);
+        SearchResult bucket = bucketEngine.run(graph, 0);
+        SearchResult radix = radixEngine.run(graph, 0);
+        ASSERT_EQ(bucket.distance, radix.distance);
+        ASSERT_EQ(bucket.settled, radix.settled);
+        ASSERT_EQ(bucketEngine.run(graph, 0).distance, bucket.distance);
+
+        // Every predecessor must be joined to its node by an arc on a shortest path
+        for (int v = 1; v < graph.nodeCount(); v++) {
+            int u = bucket.predecessor[v];
+            ASSERT_NE(u, -1);
+            bool tight = false;
+            for (const Arc &arc : graph.outArcs(u)) {
+                tight = tight || (arc.node == v && bucket.distance[u] + arc.weight == bucket.distance[v]);
+            }
+            ASSERT_TRUE(tight);
+        }
+    }
+}
+
+// Test the dispatching function falls back to the radix heap for heavy weights
+TEST(DijkstraEngineTest, HeavyWeights) {
+    Graph graph({{0, 0}, {1, 0}, {2, 0}}, {{0, 1, 100000, true}, {1, 2, 5, true}, {0, 2, 200000, true}});
+    SearchResult result = dijkstra(graph, 0);
+    ASSERT_EQ(result.distance[2], 100005);
+    ASSERT_EQ(pathEdges(result, 2), (std::vector<int>{0, 1}));
+}
+
+// Test the path is read off the edges the search used, not the first edge joining each pair of nodes
+TEST(DijkstraEngineTest, ParallelAndReverseEdges) {
+    Graph graph({{}, {}, {}}, {{0, 1, 5, true}, {1, 0, 1, true}, {0, 1, 2, false}, {1, 2, 3, true}, {1, 2, 1, true}});
+    const SearchResult result = dijkstra(graph, 0);
+    EXPECT_EQ(pathEdges(result, 2), (std::vector<int>{2, 4}));
+    EXPECT_EQ(result.predecessorEdge, (std::vector<int>{-1, 2, 4}));
+    EXPECT_EQ(shortestPath(graph, 0, 2, SolverMode::DeltaStepping).edges, (std::vector<int>{2, 4}));
+
+    // One tree answers every destination
+    EXPECT_EQ(pathTo(result, 1).edges, std::vector<int>{2});
+    EXPECT_EQ(pathTo(result, 0).edges, std::vector<int>{});
+}
+
+// Test rerouting a tree along a tied path changes the path read back to every node on it
+TEST(DijkstraEngineTest, FollowPath) {
+    Graph diamond({{}, {}, {}, {}, {}}, {{0, 1, 1, true}, {0, 2, 1, true}, {1, 3, 1, true}, {2, 3, 1, true},
+                                         {3, 4, 1, true}});
+    SearchResult tree = dijkstra(diamond, 0);
+    const std::vector<int> other = pathEdges(tree, 3) == std::vector<int>{0, 2} ? std::vector<int>{1, 3}
+                                                                                  : std::vector<int>{0, 2};
+    followPath(diamond, tree, 0, other);
+    EXPECT_EQ(pathEdges(tree, 3), other);
+    EXPECT_EQ(pathEdges(tree, 4).size(), 3u);
+    EXPECT_EQ(pathEdges(tree, 4).front(), other.front());
+}
+
+// Sums the weights along a path and checks that consecutive edges join up in their travel direction
+static int walkPath(const Graph &graph, const std::vector<int> &edges, int startNode, int endNode) {
+    int node = startNode;
+    int length = 0;
+    for (int id : edges) {
+        const GraphEdge &e = graph.edge(id);
+        if (e.source == node) {
+            node = e.dest;
+        } else {
+            EXPECT_FALSE(e.directed);
+            EXPECT_EQ(e.dest, node);
+            node = e.source;
+        }
+        length += e.weight;
+    }
+    EXPECT_EQ(node, endNode);
+    return length;
+}
+
+// Counts the simple paths from node to endNode that weigh exactly budget, by brute force
+static int countPathsOfWeight(const Graph &graph, int node, int endNode, int budget, std::vector<char> &visited) {
+    if (node == endNode) {
+        return budget == 0;
+    }
+    visited[node] = 1;
+    int count = 0;
+    for (const Arc &arc : graph.outArcs(node)) {
+        if (!visited[arc.node] && arc.weight <= budget) {
+            count += countPathsOfWeight(graph, arc.node, endNode, budget - arc.weight, visited);
+        }
+    }
+    visited[node] = 0;
+    return count;
+}
+
+// Test both engines count the shortest paths found by brute force, and that the tied paths listed are
+// distinct and all as short as the answer
+TEST(DijkstraEngineTest, CountsTiedPaths) {
+    DijkstraEngine<MaxGeneratedWeight> bucketEngine;
+    DijkstraEngine<> radixEngine;
+    for (unsigned seed = 1; seed <= 20; seed++) {
+        Graph graph = randomGraph(12, 30, 3, seed);
+        const SearchResult &bucket = bucketEngine.run(graph, 0);
+        ASSERT_EQ(radixEngine.run(graph, 0).pathCount, bucket.pathCount);
+        for (int endNode = 0; endNode < graph.nodeCount(); endNode++) {
+            std::vector<char> visited(graph.nodeCount(), 0);
+            const int expected = countPathsOfWeight(graph, 0, endNode, bucket.distance[endNode], visited);
+            ASSERT_EQ(bucket.pathCount[endNode], expected) << seed << " -> " << endNode;
+            EXPECT_EQ(pathTo(bucket, endNode).pathCount, expected);
+
+            const std::vector<std::vector<int>> tied = tiedPaths(graph, bucket, endNode, MaxPathCount);
+            ASSERT_EQ(int(tied.size()), expected);
+            EXPECT_EQ(std::set<std::vector<int>>(tied.begin(), tied.end()).size(), tied.size());
+            for (const std::vector<int> &edges : tied) {
+                EXPECT_EQ(walkPath(graph, edges, 0, endNode), bucket.distance[endNode]);
+            }
+            EXPECT_EQ(int(tiedPaths(graph, bucket, endNode, 1).size()), std::min(expected, 1));
+        }
+    }
+}
+
+// Test a diamond has two shortest paths and the counts saturate instead of overflowing on a long ladder
+TEST(DijkstraEngineTest, PathCountSaturates) {
+    Graph diamond({{}, {}, {}, {}}, {{0, 1, 1, true}, {0, 2, 1, true}, {1, 3, 1, true}, {2, 3, 1, true}});
+    EXPECT_EQ(shortestPath(diamond, 0, 3, SolverMode::Dijkstra).pathCount, 2);
+
+    // Each rung doubles the count, so 40 of them pass 2^31
+    std::vector<GraphEdge> edges;
+    for (int i = 0; i < 40; i++) {
+        edges.push_back({2 * i, 2 * i + 2, 2, true});
+        edges.push_back({2 * i, 2 * i + 1, 1, true});
+        edges.push_back({2 * i + 1, 2 * i + 2, 1, true});
+    }
+    Graph ladder(std::vector<Point>(81), edges);
+    EXPECT_EQ(dijkstra(ladder, 0).pathCount[80], MaxPathCount);
+}
+
+// Test the bidirectional search finds paths as short as plain Dijkstra and respects edge direction
+TEST(BidirectionalTest, MatchesDijkstra) {
+    for (unsigned seed = 1; seed <= 50; seed++) {
+        Graph graph = randomGraph(120, 150, MaxGeneratedWeight, seed);
+        for (int endNode : {1, 60, 119}) {
+            PathResult expected = shortestPath(graph, 0, endNode, SolverMode::Dijkstra);
+            PathResult actual = shortestPath(graph, 0, endNode, SolverMode::Bidirectional);
+            ASSERT_EQ(actual.distance, expected.distance);
+            ASSERT_EQ(walkPath(graph, actual.edges, 0, endNode), actual.distance);
+
+            // Searching against the chain exercises the directed edges in reverse
+            PathResult back = shortestPath(graph, endNode, 0, SolverMode::Bidirectional);
+            ASSERT_EQ(back.distance, shortestPath(graph, endNode, 0, SolverMode::Dijkstra).distance);
+            ASSERT_EQ(walkPath(graph, back.edges, endNode, 0), back.distance);
+        }
+    }
+}
+
+// Test unreachable and trivial queries
+TEST(BidirectionalTest, UnreachableAndTrivial) {
+    Graph graph({{0, 0}, {1, 0}, {2, 0}}, {{0, 1, 3, true}, {2, 1, 3, true}});
+    ASSERT_EQ(bidirectionalDijkstra(graph, 0, 2).distance, Unreachable);
+    ASSERT_TRUE(bidirectionalDijkstra(graph, 0, 2).edges.empty());
+    ASSERT_EQ(bidirectionalDijkstra(graph, 1, 1).distance, 0);
+    ASSERT_EQ(bidirectionalDijkstra(graph, 0, 1).edges, std::vector<int>{0});
+}
+
+// Test the bidirectional search settles far fewer nodes than a full Dijkstra on a large grid
+TEST(BidirectionalTest, SettlesFewerNodes) {
+    const int side = 100;
+    std::vector<Point> positions(side * side);
+    std::vector<GraphEdge> edges;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> weight(1, MaxGeneratedWeight);
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            if (c + 1 < side) edges.push_back({r * side + c, r * side + c + 1, weight(rng), false});
+            if (r + 1 < side) edges.push_back({r * side + c, (r + 1) * side + c, weight(rng), false});
+        }
+    }
+    Graph graph(positions, edges);
+    int startNode = (side / 2) * side + side / 4;
+    int endNode = (side / 2) * side + 3 * side / 4;
+    PathResult full = shortestPath(graph, startNode, endNode, SolverMode::Dijkstra);
+    PathResult bidirectional = shortestPath(graph, startNode, endNode, SolverMode::Bidirectional);
+    ASSERT_EQ(bidirectional.distance, full.distance);
+    ASSERT_LT(bidirectional.settled, full.settled / 2);
+}
+
+// Builds a random geometric graph, optionally with weights proportional to edge length
+static Graph geometricGraph(int numNodes, bool proportional, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coord(0.0, 1000.0);
+    std::uniform_int_distribution<int> weight(1, MaxGeneratedWeight);
+    std::vector<Point> positions(numNodes);
+    for (Point &p : positions) {
+        p = Point{coord(rng), coord(rng)};
+    }
+    std::vector<GraphEdge> edges;
+    for (int a = 0; a < numNodes; a++) {
+        for (int b = a + 1; b < numNodes; b++) {
+            double length = std::hypot(positions[a].x - positions[b].x, positions[a].y - positions[b].y);
+            if (length < 90.0) {
+                int w = proportional ? std::max(1, int(std::lround(length / 10.0))) : weight(rng);
+                edges.push_back({a, b, w, false});
+            }
+        }
+    }
+    return Graph(positions, edges);
+}
+
+// Test A* with either heuristic returns exact shortest paths
+TEST(AStarTest, MatchesDijkstra) {
+    for (unsigned seed = 1; seed <= 10; seed++) {
+        for (bool proportional : {false, true}) {
+            Graph graph = geometricGraph(400, proportional, seed);
+            for (int endNode : {50, 200, 399}) {
+                PathResult expected = shortestPath(graph, 0, endNode, SolverMode::Dijkstra);
+                PathResult euclidean = shortestPath(graph, 0, endNode, SolverMode::AStar);
+                PathResult zero = aStar(graph, 0, endNode, ZeroHeuristic());
+                ASSERT_EQ(euclidean.distance, expected.distance);
+                ASSERT_EQ(zero.distance, expected.distance);
+                if (expected.distance != Unreachable) {
+                    ASSERT_EQ(walkPath(graph, euclidean.edges, 0, endNode), expected.distance);
+                }
+                ASSERT_LE(euclidean.settled, zero.settled);
+            }
+        }
+    }
+}
+
+// Test the heuristic never overestimates the true distance to the target
+TEST(AStarTest, HeuristicIsAdmissible) {
+    Graph graph = geometricGraph(300, true, 3);
+    EuclideanHeuristic heuristic(graph, 0);
+    ASSERT_GT(heuristic.weightPerPixel(), 0.0);
+    SearchResult fromTarget = dijkstra(graph, 0);
+    for (int node = 0; node < graph.nodeCount(); node++) {
+        if (fromTarget.distance[node] != Unreachable) {
+            ASSERT_LE(heuristic(node), fromTarget.distance[node]);
+        }
+    }
+}
+
+// Test length-proportional weights make the heuristic tight enough to prune most of the graph
+TEST(AStarTest, ProportionalWeightsPrune) {
+    Graph graph = geometricGraph(2000, true, 5);
+    SearchResult reach = dijkstra(graph, 0);
+    int endNode = -1;
+    for (int node = 1; node < graph.nodeCount() && endNode == -1; node++) {
+        if (reach.distance[node] != Unreachable && std::hypot(graph.position(node).x - graph.position(0).x, graph.position(node).y - graph.position(0).y) > 300) {
+            endNode = node;
+        }
+    }
+    ASSERT_NE(endNode, -1);
+    PathResult zero = aStar(graph, 0, endNode, ZeroHeuristic());
+    PathResult euclidean = aStar(graph, 0, endNode, EuclideanHeuristic(graph, endNode));
+    ASSERT_EQ(euclidean.distance, zero.distance);
+    ASSERT_LT(euclidean.settled, zero.settled / 2);
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <set>
+#include "random.h"
+#include "spatialgrid.h"
+
+// Random points in a scene sized area
+static std::vector<Point> randomPoints(int count, Random &random) {
+    std::vector<Point> points;
+    for (int i = 0; i < count; i++) {
+        points.push_back(Point{random.bounded(7710) / 10.0, random.bounded(6000) / 10.0});
+    }
+    return points;
+}
+
+// Test a segment query reports every point within the radius, and visits each point at most once
+TEST(SpatialGridTest, SegmentQueryFindsAllNearPoints) {
+    Random random(3);
+    for (int trial = 0; trial < 50; trial++) {
+        std::vector<Point> points = randomPoints(300, random);
+        SpatialGrid grid(points, 40.0);
+        ASSERT_EQ(grid.pointCount(), 300);
+
+        for (int query = 0; query < 20; query++) {
+            Segment segment{points[random.bounded(300)], points[random.bounded(300)]};
+            std::multiset<int> visited;
+            grid.forEachNearSegment(segment, 40.0, [&](int id) { visited.insert(id); });
+
+            for (int id = 0; id < 300; id++) {
+                EXPECT_LE(visited.count(id), 1u);
+                if (distanceToSegment(points[id], segment) < 40.0) {
+                    EXPECT_EQ(visited.count(id), 1u);
+                }
+            }
+            // Only a band of cells along the segment is visited
+            EXPECT_LT(visited.size(), 300u);
+        }
+    }
+}
+
+// Test a point query reports every point within the radius, including queries outside the grid
+TEST(SpatialGridTest, PointQueryFindsAllNearPoints) {
+    Random random(4);
+    std::vector<Point> points = randomPoints(500, random);
+    SpatialGrid grid(points, 25.0);
+
+    for (Point centre : {Point{100, 100}, Point{-50, 300}, Point{900, 700}, Point{385, 300}}) {
+        std::set<int> visited;
+        grid.forEachNearPoint(centre, 60.0, [&](int id) { visited.insert(id); });
+        for (int id = 0; id < 500; id++) {
+            if (distance(points[id], centre) <= 60.0) {
+                EXPECT_TRUE(visited.count(id)) << id;
+            }
+        }
+    }
+}
+
+// Test a rectangle query reports every point inside the rectangle and skips cells far outside it
+TEST(SpatialGridTest, RectQueryFindsAllPointsInside) {
+    Random random(5);
+    std::vector<Point> points = randomPoints(500, random);
+    SpatialGrid grid(points, 25.0);
+
+    const Point topLeft{200, 150};
+    const Point bottomRight{400, 300};
+    std::multiset<int> visited;
+    grid.forEachInRect(topLeft, bottomRight, [&](int id) { visited.insert(id); });
+    for (int id = 0; id < 500; id++) {
+        EXPECT_LE(visited.count(id), 1u);
+        const Point &p = points[id];
+        if (p.x >= topLeft.x && p.x <= bottomRight.x && p.y >= topLeft.y && p.y <= bottomRight.y) {
+            EXPECT_EQ(visited.count(id), 1u) << id;
+        }
+    }
+    EXPECT_LT(visited.size(), 200u);
+}
+
+// Test an empty grid answers queries without visiting anything
+TEST(SpatialGridTest, EmptyGrid) {
+    SpatialGrid grid({}, 40.0);
+    int visits = 0;
+    grid.forEachNearSegment(Segment{{0, 0}, {100, 100}}, 40.0, [&](int) { visits++; });
+    grid.forEachNearPoint(Point{0, 0}, 40.0, [&](int) { visits++; });
+    grid.forEachInRect(Point{0, 0}, Point{100, 100}, [&](int) { visits++; });
+    EXPECT_EQ(visits, 0);
+}
@@ -4,11 +4,22 @@
 #include <QApplication>
 #include <QColor>
 #include <QLayoutItem>
+#include <QComboBox>
+#include <QLineEdit>
 #include <QRadioButton>
+#include <QGraphicsScene>
+#include <QGraphicsView>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include "widget.h"
 #include "node.h"
 #include "edge.h"
 
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
 // Test Fixture
 class WidgetTest : public ::testing::Test {
 protected:
@@ -28,181 +39,214 @@ protected:
     }
 };
 
-// Test generating nodes for uniqueness and constraints
-TEST_F(WidgetTest, GenerateNodesUniqueAndConstraintsTest) {
-    int graphType = 0; // Assuming a specific graph type for this test
-    int numOfColumns = 4; // Define the number of columns for the test
-
-    QList<Node*> nodes = widget->generateNodes(graphType, numOfColumns);
-
-    // Check if the number of nodes is within the expected range
-    EXPECT_GE(nodes.size(), numOfColumns); // Minimum number of nodes should be equal to the number of columns
-    EXPECT_LE(nodes.size(), numOfColumns * 6); // Maximum number of nodes based on the provided logic
+// Resident set size of the test process in bytes, 0 where /proc is not available
+static long residentBytes() {
+#ifdef Q_OS_LINUX
+    std::ifstream statm("/proc/self/statm");
+    long pages = 0;
+    long residentPages = 0;
+    if (statm >> pages >> residentPages) {
+        return residentPages * sysconf(_SC_PAGESIZE);
+    }
+#endif
+    return 0;
+}
 
-    // Check if all nodes are unique
-    QSet<Node*> uniqueNodes;
-    for (Node* node : nodes) {
-        uniqueNodes.insert(node);
+// Test presenting a generated question builds the scene and answer options
+TEST_F(WidgetTest, PresentQuestionTest) {
+    QuestionPipeline pipeline(widget->generatorConfig(0), SolverMode::Dijkstra);
+    Question question = pipeline.generate(42);
+    widget->resetScreen();
+    widget->presentQuestion(question);
+
+    // Check there is one scene item per node and edge
+    QList<Node*> nodes;
+    QList<Edge*> edges;
+    for (QGraphicsItem* item : widget->findChild<QGraphicsView*>()->scene()->items()) {
+        if (Node* node = dynamic_cast<Node*>(item)) {
+            nodes.append(node);
+        } else if (Edge* edge = dynamic_cast<Edge*>(item)) {
+            edges.append(edge);
+        }
     }
-    EXPECT_EQ(nodes.size(), uniqueNodes.size());
+    EXPECT_EQ(nodes.size(), question.graph.nodeCount());
+    EXPECT_EQ(edges.size(), question.graph.edgeCount());
 
-    // Check if the nodes have unique labels
-    QSet<char> uniqueLabels;
+    // Check if the start and end nodes have the correct color
+    QColor startEndNodeColour = QColor("#09814A");
     for (Node* node : nodes) {
-        uniqueLabels.insert(node->getName());
+        if (node->getId() == question.startNode || node->getId() == question.endNode) {
+            EXPECT_EQ(node->getNodeColour(), startEndNodeColour);
+        }
     }
-    EXPECT_EQ(nodes.size(), uniqueLabels.size());
 
-    // Check if the first and last nodes have the correct color
-    QColor startEndNodeColour = QColor("#09814A");
-    EXPECT_EQ(nodes.first()->getNodeColour(), startEndNodeColour);
-    EXPECT_EQ(nodes.last()->getNodeColour(), startEndNodeColour);
+    // Check the answer and the shortest path stack match the question
+    EXPECT_EQ(widget->correctAnswer, QString::fromStdString(question.answer));
+    EXPECT_EQ(widget->pathEndNode, question.endNode);
+    EXPECT_EQ(pathEdges(widget->pathTree, widget->pathEndNode), question.path.edges);
+    EXPECT_EQ(widget->findChildren<QRadioButton*>().size(), int(question.choices.size()));
+    EXPECT_EQ(widget->findChild<QLineEdit*>("seedLineEdit")->text(), QString::number(question.seed));
 }
 
-// Test generating edges for uniqueness and constraints
-TEST_F(WidgetTest, GenerateEdgesUniqueAndConstraintsTest) {
-    int graphType = 0; // Assuming a specific graph type for this test
-    int numOfColumns = 4; // Define the number of columns for the test
-
-    // Generate nodes
-    QList<Node*> nodes = widget->generateNodes(graphType, numOfColumns);
-    ASSERT_FALSE(nodes.isEmpty());
+// Test a distance question shows the distance matrix with the asked for distance hidden, and the next path
+// question does not
+TEST_F(WidgetTest, DistanceQuizTest) {
+    widget->findChild<QComboBox*>("quizModeComboBox")->setCurrentIndex(int(QuizMode::Distance));
+    GeneratorConfig config = widget->generatorConfig(0);
+    EXPECT_EQ(config.quizMode, QuizMode::Distance);
+    Question question = QuestionPipeline(config, SolverMode::Dijkstra).generate(42);
+    widget->resetScreen();
+    widget->presentQuestion(question);
+
+    EXPECT_EQ(widget->correctAnswer, QString::number(question.path.distance));
+    EXPECT_EQ(widget->graphModel->representation(), Representation::Distances);
+    EXPECT_EQ(widget->graphModel->data(widget->graphModel->index(question.startNode, question.endNode)).toString(), "?");
+    EXPECT_EQ(widget->graphModel->data(widget->graphModel->index(question.startNode, question.startNode)).toInt(), 0);
+
+    // A path question after it goes back to the adjacency matrix, as the distances would answer it
+    config.quizMode = QuizMode::ShortestPath;
+    widget->resetScreen();
+    widget->presentQuestion(QuestionPipeline(config, SolverMode::Dijkstra).generate(43));
+    EXPECT_EQ(widget->graphModel->representation(), Representation::Matrix);
+    EXPECT_EQ(widget->findChild<QComboBox*>("representationComboBox")->currentIndex(), int(Representation::Matrix));
+}
 
-    // Generate edges
-    QList<Edge*> edges = widget->generateEdges(nodes, graphType);
+// Test a distance question is asked as one even while the path mode is selected, as a prefetched or
+// bank question can be
+TEST_F(WidgetTest, QuestionKindTest) {
+    GeneratorConfig config = widget->generatorConfig(0);
+    config.quizMode = QuizMode::Distance;
+    Question question = QuestionPipeline(config, SolverMode::Dijkstra).generate(42);
+    ASSERT_EQ(widget->findChild<QComboBox*>("quizModeComboBox")->currentIndex(), int(QuizMode::ShortestPath));
+    widget->resetScreen();
+    widget->presentQuestion(question);
+
+    EXPECT_EQ(widget->correctAnswer, QString::number(question.path.distance));
+    EXPECT_EQ(widget->graphModel->representation(), Representation::Distances);
+    EXPECT_EQ(widget->graphModel->data(widget->graphModel->index(question.startNode, question.endNode)).toString(), "?");
+}
 
-    // Check if edges are not empty
-    EXPECT_FALSE(edges.isEmpty());
+// Test large graphs are labelled with numbers and the smaller ones with letters
+TEST_F(WidgetTest, LargeGraphLabelsTest) {
+    EXPECT_EQ(widget->generatorConfig(0).labelStyle, LabelStyle::Letters);
+    EXPECT_EQ(widget->generatorConfig(1).labelStyle, LabelStyle::Letters);
+    EXPECT_EQ(widget->generatorConfig(2).labelStyle, LabelStyle::Numbers);
+}
 
-    // Check if all edges are unique
-    QSet<Edge*> uniqueEdges;
-    for (Edge* edge : edges) {
-        uniqueEdges.insert(edge);
-    }
-    EXPECT_EQ(edges.size(), uniqueEdges.size());
-
-    // Check if all edges have unique source and destination nodes
-    QSet<QString> uniqueEdgeNames;
-    for (Edge* edge : edges) {
-        QString edgeName = edge->getName();
-        uniqueEdgeNames.insert(edgeName);
-        EXPECT_NE(edge->sourceNode(), edge->destNode());
-    }
-    EXPECT_EQ(edges.size(), uniqueEdgeNames.size());
+// Test the next button asks the remaining questions of a multi-destination round on the same scene,
+// then moves on to a new graph
+TEST_F(WidgetTest, MultiDestinationQuizTest) {
+    widget->findChild<QComboBox*>("quizModeComboBox")->setCurrentIndex(int(QuizMode::MultiDestination));
+    Question question = QuestionPipeline(widget->generatorConfig(1), SolverMode::Dijkstra).generate(42);
+    ASSERT_FALSE(question.destinations.empty());
+    widget->resetScreen();
+    widget->presentQuestion(question);
+    const QList<QGraphicsItem*> items = widget->findChild<QGraphicsView*>()->scene()->items();
+    widget->highlightShortestPath(Qt::green);
 
-    // Check if all edges have weights
-    for (Edge* edge : edges) {
-        EXPECT_GT(edge->getWeight(), 0);
+    int previousEndNode = question.endNode;
+    for (const Destination &destination : question.destinations) {
+        widget->on_nextGraphButton_clicked();
+        EXPECT_EQ(widget->findChild<QGraphicsView*>()->scene()->items(), items);
+        EXPECT_EQ(widget->pathEndNode, destination.endNode);
+        EXPECT_EQ(widget->correctAnswer, QString::fromStdString(destination.answer));
+        EXPECT_EQ(widget->graphModel->representation() == Representation::Distances, destination.kind == QuizMode::Distance);
+        EXPECT_EQ(pathEdges(widget->pathTree, widget->pathEndNode), destination.path.edges);
+        EXPECT_EQ(widget->nodeItems[question.startNode]->getNodeColour(), QColor("#09814A"));
+        EXPECT_EQ(widget->nodeItems[destination.endNode]->getNodeColour(), QColor("#09814A"));
+        if (previousEndNode != destination.endNode && previousEndNode != question.startNode) {
+            EXPECT_EQ(widget->nodeItems[previousEndNode]->getNodeColour(), QColor("#2C302E"));
+        }
+        for (Edge* edge : widget->edgeItems) {
+            EXPECT_NE(edge->getEdgeColour(), QColor(Qt::green));
+        }
+        previousEndNode = destination.endNode;
     }
 
-    // Check if all edges have labels
-    for (Edge* edge : edges) {
-        EXPECT_FALSE(edge->getName().isEmpty());
-    }
+    // The round is over, so the next click shows a new graph
+    widget->on_nextGraphButton_clicked();
+    EXPECT_EQ(widget->nextDestination, 0);
+    EXPECT_EQ(widget->pathEndNode, int(widget->nodeItems.size()) - 1);
 }
 
-// Test removing edges with high intersections
-TEST_F(WidgetTest, RemoveEdgesWithHighIntersectionsTest) {
-    int graphType = 0; // Assuming a specific graph type for this test
-    int numOfColumns = 4; // Define the number of columns for the test
-
-    // Generate nodes and edges
-    QList<Node*> nodes = widget->generateNodes(graphType, numOfColumns);
-    QList<Edge*> edges = widget->generateEdges(nodes, graphType);
+// Test highlighting the shortest path colours exactly the answer's edges and their nodes
+TEST_F(WidgetTest, HighlightShortestPathTest) {
+    QuestionPipeline pipeline(widget->generatorConfig(0), SolverMode::Dijkstra);
+    Question question = pipeline.generate(7);
+    widget->resetScreen();
+    widget->presentQuestion(question);
+    widget->highlightShortestPath(Qt::green);
 
-    // Count the number of intersections for each edge before removal
-    QHash<Edge*, int> initialEdgeIntersections;
-    for (Edge* edge : edges) {
-        int intersections = widget->countIntersectionsForEdge(edge, edges);
-        initialEdgeIntersections.insert(edge, intersections);
+    for (int id = 0; id < question.graph.edgeCount(); id++) {
+        const bool onPath = std::count(question.path.edges.begin(), question.path.edges.end(), id) > 0;
+        EXPECT_EQ(widget->edgeItems[id]->getEdgeColour() == Qt::green, onPath) << id;
     }
 
-    // Set an intersection limit and remove edges with intersections above the limit
-    int intersectionLimit = 2;
-    widget->removeEdgesWithHighIntersections(edges, intersectionLimit);
-
-    // Verify that edges with intersections above the limit have been removed
-    for (Edge* edge : initialEdgeIntersections.keys()) {
-        if (initialEdgeIntersections.value(edge) >= intersectionLimit) {
-            EXPECT_FALSE(edges.contains(edge));
-        }
+    // Check the nodes along the path are coloured with it and no others are
+    std::vector<bool> nodeOnPath(question.graph.nodeCount(), false);
+    for (int id : question.path.edges) {
+        nodeOnPath[question.graph.edge(id).source] = true;
+        nodeOnPath[question.graph.edge(id).dest] = true;
     }
-
-    // Verify that remaining edges have intersections below or equal to the limit
-    for (Edge* edge : edges) {
-        int intersections = widget->countIntersectionsForEdge(edge, edges);
-        EXPECT_LE(intersections, intersectionLimit);
+    for (int node = 0; node < question.graph.nodeCount(); node++) {
+        EXPECT_EQ(widget->nodeItems[node]->getNodeColour() == Qt::green, nodeOnPath[node]) << node;
     }
-
-    // Check if the remaining edges are still valid and unique
-    QSet<Edge*> uniqueEdges(edges.begin(), edges.end());
-    EXPECT_EQ(edges.size(), uniqueEdges.size());
 }
 
-// Test removing node-intersecting edges
-TEST_F(WidgetTest, RemoveNodeIntersectingEdgesTest) {
-    int graphType = 0; // Assuming a specific graph type for this test
-    int numOfColumns = 4; // Define the number of columns for the test
-
-    // Generate nodes and edges
-    QList<Node*> nodes = widget->generateNodes(graphType, numOfColumns);
-    QList<Edge*> edges = widget->generateEdges(nodes, graphType);
-
-    // Store the initial list of edges
-    QList<Edge*> initialEdges = edges;
-
-    // Remove edges that intersect with nodes
-    widget->removeNodeIntersectingEdges(nodes, edges);
-
-    // Define the threshold distance for intersection
-    qreal threshold = 40.0;
-
-    // Verify that edges intersecting with nodes (except their source and destination nodes) have been removed
-    for (Edge* edge : initialEdges) {
-        QLineF edgeLine(edge->sourcePoint, edge->destPoint);
-        bool intersectsNode = false;
-
-        for (Node* node : nodes) {
-            if (node == edge->sourceNode() || node == edge->destNode()) {
-                continue; // Skip this node, as it's part of the edge
-            }
-
-            for (qreal step = 0.0; step <= 1; step += 0.1) {
-                qreal dist = QLineF(node->pos(), edgeLine.pointAt(step)).length();
-                if (dist < threshold) {
-                    intersectsNode = true;
-                    break;
-                }
-            }
-
-            if (intersectsNode) {
-                break;
-            }
-        }
-
-        if (intersectsNode) {
-            EXPECT_FALSE(edges.contains(edge));
-        } else {
-            EXPECT_TRUE(edges.contains(edge));
-        }
-    }
-
-    // Check if the remaining edges are still valid and unique
-    QSet<Edge*> uniqueEdges(edges.begin(), edges.end());
-    EXPECT_EQ(edges.size(), uniqueEdges.size());
+// Test a question read from a bank, which carries no tree, still highlights its stored path
+TEST_F(WidgetTest, HighlightWithoutTreeTest) {
+    Question question = QuestionPipeline(widget->generatorConfig(0), SolverMode::Dijkstra).generate(11);
+    question.tree = SearchResult();
+    widget->resetScreen();
+    widget->presentQuestion(question);
+    EXPECT_EQ(pathEdges(widget->pathTree, question.endNode), question.path.edges);
 }
 
-// Test highlighting the shortest path
-TEST_F(WidgetTest, HighlightShortestPathTest) {
-    QList<Node*> nodes = widget->generateNodes(0, 4);
-    QList<Edge*> edges = widget->generateEdges(nodes, 0);
-    std::stack<Edge*> shortestPath = widget->dijkstrasAlgorithm(nodes.first(), nodes.last(), nodes, edges);
-    widget->shortestPath = shortestPath;  // Set the global shortestPath
-    widget->highlightShortestPath(Qt::green);
+// Test resetting the screen forgets every item the scene deleted, for a large question with batched
+// edges and for an imported graph
+TEST_F(WidgetTest, ResetScreenTest) {
+    QGraphicsScene *scene = widget->findChild<QGraphicsView*>()->scene();
+    widget->resetScreen();
+    widget->presentQuestion(QuestionPipeline(widget->generatorConfig(2), SolverMode::Dijkstra).generate(1));
+    ASSERT_NE(widget->edgeBatch, nullptr);
+    ASSERT_FALSE(widget->nodeItems.isEmpty());
+    widget->resetScreen();
+    EXPECT_TRUE(scene->items().isEmpty());
+    EXPECT_TRUE(widget->nodeItems.isEmpty());
+    EXPECT_TRUE(widget->edgeItems.isEmpty());
+    EXPECT_EQ(widget->edgeBatch, nullptr);
+    EXPECT_EQ(widget->pathEndNode, -1);
+
+    const std::string fileName = ::testing::TempDir() + "widget_test.txt";
+    std::ofstream(fileName) << "0 1 3\n1 2 4\n";
+    ASSERT_TRUE(widget->openGraph(QString::fromStdString(fileName)));
+    ASSERT_NE(widget->importedGraph, nullptr);
+    widget->resetScreen();
+    EXPECT_TRUE(scene->items().isEmpty());
+    EXPECT_EQ(widget->importedGraph, nullptr);
+    std::remove(fileName.c_str());
+}
 
-    while (!shortestPath.empty()) {
-        Edge* edge = shortestPath.top();
-        shortestPath.pop();
-        EXPECT_EQ(edge->getEdgeColour(), Qt::green);
+// Soak test: showing 10k questions one after another keeps the same scene and does not grow the
+// process once the allocator has warmed up
+TEST_F(WidgetTest, SoakTest) {
+    if (residentBytes() == 0) {
+        GTEST_SKIP() << "Resident set size is not available on this platform";
+    }
+    QGraphicsView *view = widget->findChild<QGraphicsView*>();
+    QGraphicsScene *scene = view->scene();
+    QuestionPipeline pipeline(widget->generatorConfig(0), SolverMode::Dijkstra);
+    long warmedUp = 0;
+    for (uint64_t seed = 1; seed <= 10000; seed++) {
+        widget->resetScreen();
+        widget->presentQuestion(pipeline.generate(seed));
+        if (seed == 1000) {
+            warmedUp = residentBytes();
+        }
     }
+    EXPECT_EQ(view->scene(), scene);
+    // AddressSanitizer holds freed memory in quarantine and reports leaks itself, so the bound only holds without it
+#ifndef __SANITIZE_ADDRESS__
+    EXPECT_LT(residentBytes() - warmedUp, 8L << 20) << "Grew from " << warmedUp << " bytes";
+#endif
 }
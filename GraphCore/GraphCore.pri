@@ -0,0 +1,39 @@
+# Headless graph core, included by every project that needs the graph, solvers or generators
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+SOURCES += $$PWD/allpairs.cpp \
+           $$PWD/crossinggraph.cpp \
+           $$PWD/deltastepping.cpp \
+           $$PWD/graph.cpp \
+           $$PWD/graphgenerator.cpp \
+           $$PWD/graphimporter.cpp \
+           $$PWD/kdtree.cpp \
+           $$PWD/kshortestpaths.cpp \
+           $$PWD/nodelabel.cpp \
+           $$PWD/question.cpp \
+           $$PWD/questionbank.cpp \
+           $$PWD/segmentgrid.cpp \
+           $$PWD/shortestpath.cpp \
+           $$PWD/spatialgrid.cpp \
+           $$PWD/workstealingpool.cpp
+
+HEADERS += $$PWD/allpairs.h \
+           $$PWD/bucketqueue.h \
+           $$PWD/crossinggraph.h \
+           $$PWD/deltastepping.h \
+           $$PWD/geometry.h \
+           $$PWD/graph.h \
+           $$PWD/graphgenerator.h \
+           $$PWD/graphimporter.h \
+           $$PWD/kdtree.h \
+           $$PWD/kshortestpaths.h \
+           $$PWD/nodelabel.h \
+           $$PWD/question.h \
+           $$PWD/questionbank.h \
+           $$PWD/random.h \
+           $$PWD/segmentgrid.h \
+           $$PWD/shortestpath.h \
+           $$PWD/spatialgrid.h \
+           $$PWD/workstealingpool.h
@@ -0,0 +1,10 @@
+# Define the target
+TARGET = GraphCore
+TEMPLATE = lib
+
+# Build a static library without any Qt dependency
+CONFIG += staticlib c++17
+CONFIG -= qt
+
+# Add the source and header files
+include(GraphCore.pri)
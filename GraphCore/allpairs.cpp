@@ -0,0 +1,146 @@
+#include "allpairs.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+constexpr int Tile = 32; // Rows and columns of a tile; three tiles of ints fit in a 32 KB L1 cache
+constexpr int Infinity = std::numeric_limits<int>::max() / 2; // Missing path, small enough that two of them add up without overflow
+
+// Relaxes every entry of tile c through the entries of tile a's column k and tile b's row k, for each k
+// of the tile. The tiles may be the same one: the entries on the k-th row and column cannot improve
+// during round k, as the diagonal entry is zero. That also makes it safe to copy row k out first, which
+// tells the compiler the row cannot alias the entries being written, so the j loop vectorises.
+void relaxTile(int *c, const int *a, const int *b, int stride) {
+    int bRow[Tile];
+    for (int k = 0; k < Tile; k++) {
+        std::copy(b + size_t(k) * stride, b + size_t(k) * stride + Tile, bRow);
+        for (int i = 0; i < Tile; i++) {
+            int *cRow = c + size_t(i) * stride;
+            const int aik = a[size_t(i) * stride + k];
+            for (int j = 0; j < Tile; j++) {
+                cRow[j] = std::min(cRow[j], aik + bRow[j]);
+            }
+        }
+    }
+}
+
+// Runs one search from every node, copying each distance array into its matrix row
+template<class Engine>
+void searchFromEveryNode(const Graph &graph, WorkStealingPool *pool, DistanceMatrix &matrix) {
+    const int n = graph.nodeCount();
+    const auto searchFrom = [&](Engine &engine, int node) {
+        const SearchResult &result = engine.run(graph, node);
+        std::copy(result.distance.begin(), result.distance.end(), matrix.distances.begin() + size_t(node) * n);
+    };
+    if (!pool) {
+        Engine engine;
+        for (int node = 0; node < n; node++) {
+            searchFrom(engine, node);
+        }
+        return;
+    }
+
+    // Each worker reuses its own engine's queue and result storage
+    std::vector<Engine> engines(pool->threadCount());
+    pool->parallelFor(0, n, [&](int node, int worker) {
+        searchFrom(engines[worker], node);
+    });
+}
+
+} // namespace
+
+// Fills a padded matrix with the edge weights, runs the tiled rounds and copies the real nodes out
+DistanceMatrix floydWarshall(const Graph &graph) {
+    // Paths heavier than the padding value cannot be told apart from missing ones
+    long long totalWeight = 0;
+    for (const GraphEdge &e : graph.edges()) {
+        totalWeight += e.weight;
+    }
+    if (totalWeight >= Infinity) {
+        return repeatedDijkstra(graph);
+    }
+
+    const int n = graph.nodeCount();
+    const int tiles = (n + Tile - 1) / Tile;
+    const int stride = tiles * Tile;
+    std::vector<int> d(size_t(stride) * stride, Infinity);
+    for (int i = 0; i < stride; i++) {
+        d[size_t(i) * stride + i] = 0;
+    }
+    for (const GraphEdge &e : graph.edges()) {
+        int &forward = d[size_t(e.source) * stride + e.dest];
+        forward = std::min(forward, e.weight);
+        if (!e.directed) {
+            int &backward = d[size_t(e.dest) * stride + e.source];
+            backward = std::min(backward, e.weight);
+        }
+    }
+
+    const auto tile = [&](int row, int column) {
+        return d.data() + size_t(row) * Tile * stride + size_t(column) * Tile;
+    };
+    for (int kb = 0; kb < tiles; kb++) {
+        // The diagonal tile first, as every other tile of the round reads it
+        int *diagonal = tile(kb, kb);
+        relaxTile(diagonal, diagonal, diagonal, stride);
+
+        // Then the tiles sharing its row or column
+        for (int b = 0; b < tiles; b++) {
+            if (b != kb) {
+                relaxTile(tile(kb, b), diagonal, tile(kb, b), stride);
+                relaxTile(tile(b, kb), tile(b, kb), diagonal, stride);
+            }
+        }
+
+        // Then every other tile, through the row and column tiles just finished
+        for (int ib = 0; ib < tiles; ib++) {
+            if (ib == kb) {
+                continue;
+            }
+            for (int jb = 0; jb < tiles; jb++) {
+                if (jb != kb) {
+                    relaxTile(tile(ib, jb), tile(ib, kb), tile(kb, jb), stride);
+                }
+            }
+        }
+    }
+
+    DistanceMatrix matrix;
+    matrix.nodeCount = n;
+    matrix.distances.resize(size_t(n) * n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            const int value = d[size_t(i) * stride + j];
+            matrix.distances[size_t(i) * n + j] = value >= Infinity ? Unreachable : value;
+        }
+    }
+    return matrix;
+}
+
+// Solves from every node with the bucket queue engine when the weights fit its bound
+DistanceMatrix repeatedDijkstra(const Graph &graph, WorkStealingPool *pool) {
+    DistanceMatrix matrix;
+    matrix.nodeCount = graph.nodeCount();
+    matrix.distances.resize(size_t(matrix.nodeCount) * matrix.nodeCount);
+    if (graph.maxWeight() <= MaxGeneratedWeight) {
+        searchFromEveryNode<DijkstraEngine<MaxGeneratedWeight>>(graph, pool, matrix);
+    } else {
+        searchFromEveryNode<DijkstraEngine<>>(graph, pool, matrix);
+    }
+    return matrix;
+}
+
+// Picks the strategy from the size of the graph and its number of arcs per node
+DistanceMatrix allPairs(const Graph &graph, WorkStealingPool *pool) {
+    const long long n = graph.nodeCount();
+    long long arcs = 0;
+    for (int node = 0; node < n; node++) {
+        arcs += graph.outArcs(node).size();
+    }
+    if (n <= FloydWarshallNodes || arcs * DenseFraction >= n * n) {
+        return floydWarshall(graph);
+    }
+    return repeatedDijkstra(graph, pool);
+}
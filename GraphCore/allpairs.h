@@ -0,0 +1,38 @@
+#ifndef ALLPAIRS_H
+#define ALLPAIRS_H
+
+#include "graph.h"
+#include "shortestpath.h"
+#include "workstealingpool.h"
+
+#include <vector>
+
+// Shortest distances between every ordered pair of nodes
+struct DistanceMatrix {
+    int nodeCount = 0; // Number of rows and columns
+    std::vector<int> distances; // Row-major distances, Unreachable where there is no path
+
+    int at(int from, int to) const { return distances[size_t(from) * nodeCount + to]; }
+};
+
+// allPairs solves graphs of up to this many nodes with Floyd-Warshall whatever their density; the
+// whole matrix then fits in cache and the vectorised loop beats one Dijkstra per node even on sparse
+// graphs. Measured with the all-pairs benchmarks.
+constexpr int FloydWarshallNodes = 128;
+
+// Larger graphs use Floyd-Warshall once a node has on average at least 1 / DenseFraction of the other
+// nodes as neighbours, where the cubic loop still undercuts the Dijkstra searches.
+constexpr int DenseFraction = 4;
+
+// Floyd-Warshall over square tiles of the matrix. Each round of the k loop is split into the diagonal
+// tile, the tiles in its row and column, then the rest, so three tiles are live at a time and stay in
+// cache; the innermost loop runs along a contiguous row with no branches, which compilers vectorise.
+DistanceMatrix floydWarshall(const Graph &graph);
+
+// One Dijkstra search from every node, spread over a pool's workers if one is given
+DistanceMatrix repeatedDijkstra(const Graph &graph, WorkStealingPool *pool = nullptr);
+
+// All-pairs distances, using Floyd-Warshall for dense graphs and repeated Dijkstra for sparse ones
+DistanceMatrix allPairs(const Graph &graph, WorkStealingPool *pool = nullptr);
+
+#endif // ALLPAIRS_H
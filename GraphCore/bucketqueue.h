@@ -0,0 +1,156 @@
+#ifndef BUCKETQUEUE_H
+#define BUCKETQUEUE_H
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Dial's circular bucket queue for integer keys where every key in the queue lies within
+// MaxWeight of the current minimum. Buckets are intrusive doubly linked lists threaded
+// through per-node arrays, so push, update and pop never allocate once reset() has sized them.
+template <int MaxWeight>
+class DialQueue {
+    static_assert(MaxWeight > 0, "DialQueue needs a positive weight bound");
+    static constexpr int NumBuckets = MaxWeight + 1;
+
+public:
+    // Prepares the queue for node ids in [0, numNodes)
+    void reset(int numNodes) {
+        if (int(next.size()) < numNodes) {
+            next.resize(numNodes);
+            prev.resize(numNodes);
+        }
+        heads.fill(-1);
+        current = 0;
+        count = 0;
+    }
+
+    bool empty() const { return count == 0; }
+
+    // Inserts a node that is not yet in the queue
+    void push(int node, int key) {
+        link(node, key % NumBuckets);
+        count++;
+    }
+
+    // Moves a queued node from its old key to a smaller one
+    void update(int node, int oldKey, int newKey) {
+        unlink(node, oldKey % NumBuckets);
+        link(node, newKey % NumBuckets);
+    }
+
+    // Removes a node with the smallest key and returns it together with that key
+    std::pair<int, int> pop() {
+        int bucket = current % NumBuckets;
+        while (heads[bucket] == -1) {
+            current++;
+            bucket = bucket + 1 == NumBuckets ? 0 : bucket + 1;
+        }
+        int node = heads[bucket];
+        unlink(node, bucket);
+        count--;
+        return {node, current};
+    }
+
+private:
+    void link(int node, int bucket) {
+        prev[node] = -1;
+        next[node] = heads[bucket];
+        if (heads[bucket] != -1) {
+            prev[heads[bucket]] = node;
+        }
+        heads[bucket] = node;
+    }
+
+    void unlink(int node, int bucket) {
+        if (prev[node] != -1) {
+            next[prev[node]] = next[node];
+        } else {
+            heads[bucket] = next[node];
+        }
+        if (next[node] != -1) {
+            prev[next[node]] = prev[node];
+        }
+    }
+
+    std::array<int, NumBuckets> heads; // First node in each bucket, -1 if empty
+    std::vector<int> next; // Next node in the same bucket
+    std::vector<int> prev; // Previous node in the same bucket
+    int current = 0; // Smallest key that can still be in the queue
+    int count = 0; // Number of queued nodes
+};
+
+// Radix heap for monotone integer keys of any size. Entries are filed by the highest bit in which
+// they differ from the last popped key, so each entry moves between buckets at most 32 times.
+// Bucket storage is kept between runs, so steady-state use does not allocate.
+class RadixHeap {
+public:
+    // Empties the heap while keeping bucket capacity
+    void reset() {
+        for (auto &bucket : buckets) {
+            bucket.clear();
+        }
+        last = 0;
+        count = 0;
+    }
+
+    bool empty() const { return count == 0; }
+
+    // Inserts an entry, the key must not be smaller than the last popped key
+    void push(int node, int key) {
+        buckets[bucketIndex(uint32_t(key))].push_back({uint32_t(key), node});
+        count++;
+    }
+
+    // Removes an entry with the smallest key and returns its node and key
+    std::pair<int, int> pop() {
+        if (buckets[0].empty()) {
+            // Find the first non-empty bucket and redistribute it around its minimum
+            int i = 1;
+            while (buckets[i].empty()) {
+                i++;
+            }
+            uint32_t minKey = buckets[i].front().first;
+            for (const auto &entry : buckets[i]) {
+                if (entry.first < minKey) {
+                    minKey = entry.first;
+                }
+            }
+            last = minKey;
+            for (const auto &entry : buckets[i]) {
+                buckets[bucketIndex(entry.first)].push_back(entry);
+            }
+            buckets[i].clear();
+        }
+        std::pair<uint32_t, int> entry = buckets[0].back();
+        buckets[0].pop_back();
+        count--;
+        return {entry.second, int(entry.first)};
+    }
+
+private:
+    // Index of the bucket for a key relative to the last popped key
+    int bucketIndex(uint32_t key) const {
+        uint32_t diff = key ^ last;
+        if (diff == 0) {
+            return 0;
+        }
+#if defined(__GNUC__) || defined(__clang__)
+        return 32 - __builtin_clz(diff);
+#else
+        int bits = 0;
+        while (diff != 0) {
+            diff >>= 1;
+            bits++;
+        }
+        return bits;
+#endif
+    }
+
+    std::array<std::vector<std::pair<uint32_t, int>>, 33> buckets; // Entries as (key, node)
+    uint32_t last = 0; // Last popped key
+    int count = 0; // Number of entries, including stale ones
+};
+
+#endif // BUCKETQUEUE_H
@@ -0,0 +1,171 @@
+#include "crossinggraph.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+// Pi, spelled out because M_PI is not standard C++ and MSVC only defines it on request
+constexpr double Pi = 3.14159265358979323846;
+
+// Direction window in radians inside which two segments count as nearly parallel
+constexpr double ParallelWindow = 1e-5;
+
+// Axis aligned bounds of a segment, padded to absorb rounding in segmentsIntersect
+struct Bounds {
+    double minX, maxX, minY, maxY;
+};
+
+Bounds segmentBounds(const Segment &s) {
+    Bounds b{std::min(s.p1.x, s.p2.x), std::max(s.p1.x, s.p2.x), std::min(s.p1.y, s.p2.y), std::max(s.p1.y, s.p2.y)};
+    const double pad = 1e-6 * (1 + std::max({std::fabs(b.minX), std::fabs(b.maxX), std::fabs(b.minY), std::fabs(b.maxY)}));
+    return Bounds{b.minX - pad, b.maxX + pad, b.minY - pad, b.maxY + pad};
+}
+
+// Collapsed segments have no direction, so segmentsIntersect never counts them
+bool isDegenerate(const Segment &s) {
+    return s.p1.x == s.p2.x && s.p1.y == s.p2.y;
+}
+
+// Checks if two padded boxes overlap
+bool overlaps(const Bounds &a, const Bounds &b) {
+    return a.minX <= b.maxX && b.minX <= a.maxX && a.minY <= b.maxY && b.minY <= a.maxY;
+}
+
+// Direction of a segment in [0, pi), so opposite directions compare equal
+double direction(const Segment &s) {
+    double angle = std::atan2(s.p2.y - s.p1.y, s.p2.x - s.p1.x);
+    if (angle < 0) {
+        angle += Pi;
+    }
+    return angle >= Pi ? 0.0 : angle;
+}
+
+} // namespace
+
+// CrossingGraph constructor finds every crossing pair and fills the heap with the initial counts
+CrossingGraph::CrossingGraph(const std::vector<Segment> &segments)
+    : counts(segments.size(), 0), crossers(segments.size()), removed(segments.size(), 0)
+{
+    addCrossings(segments);
+    for (int edge = 0; edge < size(); edge++) {
+        heap.push({counts[edge], -edge});
+    }
+}
+
+// Finds the crossing pairs in two passes. The sweep covers every pair whose boxes overlap. Rounding in
+// segmentsIntersect can also report nearly parallel segments as crossing when they lie on one line but
+// far apart, which happens for chains of nodes on a line; those pairs are covered by a pass over the
+// segments sorted by direction.
+void CrossingGraph::addCrossings(const std::vector<Segment> &segments) {
+    std::vector<Bounds> bounds;
+    bounds.reserve(segments.size());
+    std::vector<int> order;
+    for (int i = 0; i < int(segments.size()); i++) {
+        bounds.push_back(segmentBounds(segments[i]));
+        if (!isDegenerate(segments[i])) {
+            order.push_back(i);
+        }
+    }
+
+    // Tests a pair in both orders, as counting each edge separately did
+    auto testPair = [&](int first, int second) {
+        if (segmentsIntersect(segments[first], segments[second])) {
+            counts[first]++;
+            crossers[second].push_back(first);
+        }
+        if (segmentsIntersect(segments[second], segments[first])) {
+            counts[second]++;
+            crossers[first].push_back(second);
+        }
+    };
+
+    // Sweep a vertical line from left to right. Segments enter the active list at their left end and
+    // leave once the line passes their right end
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return bounds[a].minX < bounds[b].minX || (bounds[a].minX == bounds[b].minX && a < b);
+    });
+    std::vector<int> active;
+    for (int current : order) {
+        const Bounds &box = bounds[current];
+
+        // Drop segments that end before this one starts
+        active.erase(std::remove_if(active.begin(), active.end(),
+                                    [&](int other) { return bounds[other].maxX < box.minX; }),
+                     active.end());
+
+        for (int other : active) {
+            if (bounds[other].maxY >= box.minY && bounds[other].minY <= box.maxY) {
+                testPair(current, other);
+            }
+        }
+        active.push_back(current);
+    }
+
+    // Nearly parallel pairs with separate boxes, including directions either side of the 0 / pi wrap
+    std::vector<std::pair<double, int>> directions;
+    for (int i : order) {
+        directions.push_back({direction(segments[i]), i});
+    }
+    std::sort(directions.begin(), directions.end());
+    const int n = int(directions.size());
+    for (int k = 0; k < n; k++) {
+        for (int j = k + 1; j < n && directions[j].first - directions[k].first < ParallelWindow; j++) {
+            if (!overlaps(bounds[directions[k].second], bounds[directions[j].second])) {
+                testPair(directions[k].second, directions[j].second);
+            }
+        }
+    }
+    for (int k = n - 1; k >= 0 && directions[k].first > Pi - ParallelWindow; k--) {
+        for (int j = 0; j < k && directions[j].first + Pi - directions[k].first < ParallelWindow; j++) {
+            if (!overlaps(bounds[directions[k].second], bounds[directions[j].second])) {
+                testPair(directions[k].second, directions[j].second);
+            }
+        }
+    }
+}
+
+// Returns the number of segments
+int CrossingGraph::size() const {
+    return int(counts.size());
+}
+
+// Returns the live crossing count of an edge
+int CrossingGraph::crossingCount(int edge) const {
+    return counts[edge];
+}
+
+// Returns whether an edge was removed
+bool CrossingGraph::isRemoved(int edge) const {
+    return removed[edge];
+}
+
+// Returns the edges whose count includes this edge
+const std::vector<int> &CrossingGraph::crossedBy(int edge) const {
+    return crossers[edge];
+}
+
+// Pops stale heap entries until the top matches a present edge's current count
+int CrossingGraph::mostCrossedEdge() {
+    while (!heap.empty()) {
+        auto [count, negatedEdge] = heap.top();
+        const int edge = -negatedEdge;
+        if (!removed[edge] && counts[edge] == count) {
+            return edge;
+        }
+        heap.pop();
+    }
+    return -1;
+}
+
+// Removes an edge; counts only ever fall, so each affected edge gets a fresh heap entry
+void CrossingGraph::remove(int edge) {
+    removed[edge] = 1;
+    for (int other : crossers[edge]) {
+        if (!removed[other]) {
+            counts[other]--;
+            heap.push({counts[other], -other});
+        }
+    }
+}
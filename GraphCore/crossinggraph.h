@@ -0,0 +1,34 @@
+#ifndef CROSSINGGRAPH_H
+#define CROSSINGGRAPH_H
+
+#include "geometry.h"
+
+#include <queue>
+#include <utility>
+#include <vector>
+
+// Records which edge segments cross which, so pruning can remove edges without recounting every pair.
+// The pairs are found once with a sweep line over x; each candidate pair is confirmed with
+// segmentsIntersect in both directions, so the counts are exactly those of countIntersectionsForEdge.
+class CrossingGraph {
+public:
+    explicit CrossingGraph(const std::vector<Segment> &segments);
+
+    int size() const; // Number of segments, including removed ones
+    int crossingCount(int edge) const; // Segments still present that this segment crosses
+    bool isRemoved(int edge) const; // Whether an edge was removed
+    int mostCrossedEdge(); // Present edge with the most crossings, the lowest index on ties, -1 when all are removed
+    void remove(int edge); // Removes an edge and updates the counts of the edges it crossed
+
+    const std::vector<int> &crossedBy(int edge) const; // Segments that count this segment as a crossing
+
+private:
+    void addCrossings(const std::vector<Segment> &segments); // Sweep line pass filling the crossing lists
+
+    std::vector<int> counts; // Live crossing count per edge
+    std::vector<std::vector<int>> crossers; // Per edge, the edges whose count includes it
+    std::vector<char> removed; // Removed flag per edge
+    std::priority_queue<std::pair<int, int>> heap; // (count, -edge) entries, stale ones are skipped when popped
+};
+
+#endif // CROSSINGGRAPH_H
@@ -0,0 +1,239 @@
+#include "deltastepping.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace {
+
+constexpr int RelaxChunk = 256; // Frontier nodes per pool task
+constexpr int MaxBuckets = 1 << 16; // Most buckets kept; a narrower width is widened to fit
+
+} // namespace
+
+// Spreads the largest weight over the average number of arcs per node
+int defaultDelta(const Graph &graph) {
+    if (graph.nodeCount() == 0) {
+        return 1;
+    }
+    long long arcs = 0;
+    for (int node = 0; node < graph.nodeCount(); node++) {
+        arcs += graph.outArcs(node).size();
+    }
+    const double arcsPerNode = std::max(1.0, double(arcs) / graph.nodeCount());
+    return std::max(1, int(graph.maxWeight() / arcsPerNode));
+}
+
+// DeltaStepping constructor keeps one list of lowered nodes per worker
+DeltaStepping::DeltaStepping(WorkStealingPool *pool, int delta)
+    : pool(pool), requestedDelta(std::max(0, delta)), improved(pool ? pool->threadCount() : 1)
+{
+}
+
+// Sets the bucket width for the next runs
+void DeltaStepping::setDelta(int delta) {
+    requestedDelta = std::max(0, delta);
+}
+
+// Returns the bucket width asked for
+int DeltaStepping::delta() const {
+    return requestedDelta;
+}
+
+// Works through the buckets in distance order. Only tentative distances within the largest weight of
+// the current bucket can be pending, so the buckets are reused cyclically.
+const SearchResult &DeltaStepping::run(const Graph &graph, int startNode) {
+    const int numNodes = graph.nodeCount();
+    width = requestedDelta > 0 ? requestedDelta : defaultDelta(graph);
+    if (graph.maxWeight() / width >= MaxBuckets) {
+        width = graph.maxWeight() / (MaxBuckets - 1) + 1;
+    }
+    const int bucketCount = graph.maxWeight() / width + 2;
+    buckets.resize(bucketCount);
+    for (std::vector<int> &bucket : buckets) {
+        bucket.clear();
+    }
+    if (int(distance.size()) != numNodes) {
+        distance = std::vector<std::atomic<int>>(numNodes);
+    }
+    for (std::atomic<int> &d : distance) {
+        d.store(Unreachable, std::memory_order_relaxed);
+    }
+    queuedIn.assign(numNodes, -1);
+    settledIn.assign(numNodes, -1);
+
+    distance[startNode].store(0, std::memory_order_relaxed);
+    buckets[0].push_back(startNode);
+    std::vector<int> frontier;
+    std::vector<int> settled;
+    int current = 0; // Index of the bucket being emptied, counting every bucket passed
+    int round = 0; // Number of light rounds so far
+    for (;;) {
+        // Move on to the next bucket with entries, stopping once they are all empty
+        int step = 0;
+        while (step < bucketCount && buckets[(current + step) % bucketCount].empty()) {
+            step++;
+        }
+        if (step == bucketCount) {
+            break;
+        }
+        current += step;
+        std::vector<int> &bucket = buckets[current % bucketCount];
+
+        // Relax light arcs until the bucket stops refilling, skipping entries left behind by nodes that
+        // have since moved to a lower bucket
+        settled.clear();
+        while (!bucket.empty()) {
+            round++;
+            frontier.clear();
+            for (int node : bucket) {
+                if (distance[node].load(std::memory_order_relaxed) / width == current && queuedIn[node] != round) {
+                    queuedIn[node] = round;
+                    frontier.push_back(node);
+                    if (settledIn[node] != current) {
+                        settledIn[node] = current;
+                        settled.push_back(node);
+                    }
+                }
+            }
+            bucket.clear();
+            relax(graph, frontier, true);
+        }
+
+        // The bucket's distances are final, so each heavy arc only needs relaxing once
+        relax(graph, settled, false);
+    }
+
+    result.distance.resize(numNodes);
+    result.settled = 0;
+    for (int node = 0; node < numNodes; node++) {
+        result.distance[node] = distance[node].load(std::memory_order_relaxed);
+        result.settled += result.distance[node] != Unreachable;
+    }
+    fillPredecessors(graph, startNode);
+    return result;
+}
+
+// Relaxes a frontier, across the pool when it is large enough, then files every lowered node under
+// its new bucket. A node lowered twice is filed twice; the stale entry is skipped when its bucket comes up.
+void DeltaStepping::relax(const Graph &graph, const std::vector<int> &nodes, bool light) {
+    const int count = int(nodes.size());
+    if (!pool || count < ParallelFrontier) {
+        relaxRange(graph, nodes, 0, count, light, improved[0]);
+    } else {
+        pool->parallelFor(0, (count + RelaxChunk - 1) / RelaxChunk, [&](int chunk, int worker) {
+            relaxRange(graph, nodes, chunk * RelaxChunk, std::min(count, (chunk + 1) * RelaxChunk), light,
+                       improved[worker]);
+        });
+    }
+
+    const int bucketCount = int(buckets.size());
+    for (std::vector<int> &lowered : improved) {
+        for (int node : lowered) {
+            buckets[distance[node].load(std::memory_order_relaxed) / width % bucketCount].push_back(node);
+        }
+        lowered.clear();
+    }
+}
+
+// Lowers the distances across the light or heavy arcs of a slice of the frontier. A distance lowered
+// by two threads at once keeps the smaller value, as each only stores over a larger one.
+void DeltaStepping::relaxRange(const Graph &graph, const std::vector<int> &nodes, int first, int last, bool light,
+                               std::vector<int> &lowered) {
+    for (int i = first; i < last; i++) {
+        const int node = nodes[i];
+        const int nodeDistance = distance[node].load(std::memory_order_relaxed);
+        for (const Arc &arc : graph.outArcs(node)) {
+            if ((arc.weight <= width) != light) {
+                continue;
+            }
+            const int newDist = nodeDistance + arc.weight;
+            int oldDist = distance[arc.node].load(std::memory_order_relaxed);
+            while (newDist < oldDist) {
+                if (distance[arc.node].compare_exchange_weak(oldDist, newDist, std::memory_order_relaxed)) {
+                    lowered.push_back(arc.node);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// Takes the lowest numbered node closer to the start as each node's predecessor, and the lowest numbered
+// edge from it that keeps the distance. Nodes reached only over zero weight arcs from nodes as far away
+// are joined afterwards, each to the lowest numbered neighbour already joined, so the predecessors always
+// form a tree.
+void DeltaStepping::fillPredecessors(const Graph &graph, int startNode) {
+    const int numNodes = graph.nodeCount();
+    std::vector<int> &predecessor = result.predecessor;
+    std::vector<int> &predecessorEdge = result.predecessorEdge;
+    predecessor.assign(numNodes, -1);
+    predecessorEdge.assign(numNodes, -1);
+    const auto precedes = [](const Arc &arc, const Arc *best) {
+        return !best || arc.node < best->node || (arc.node == best->node && arc.edge < best->edge);
+    };
+    const auto joinCloser = [&](int node) {
+        const Arc *best = nullptr;
+        if (node != startNode && result.distance[node] != Unreachable) {
+            for (const Arc &arc : graph.inArcs(node)) {
+                if (arc.weight > 0 && result.distance[arc.node] != Unreachable
+                    && result.distance[arc.node] + arc.weight == result.distance[node] && precedes(arc, best)) {
+                    best = &arc;
+                }
+            }
+        }
+        if (best) {
+            predecessor[node] = best->node;
+            predecessorEdge[node] = best->edge;
+        }
+    };
+    if (!pool || numNodes < ParallelFrontier) {
+        for (int node = 0; node < numNodes; node++) {
+            joinCloser(node);
+        }
+    } else {
+        pool->parallelFor(0, (numNodes + RelaxChunk - 1) / RelaxChunk, [&](int chunk, int) {
+            for (int node = chunk * RelaxChunk; node < std::min(numNodes, (chunk + 1) * RelaxChunk); node++) {
+                joinCloser(node);
+            }
+        });
+    }
+
+    // Join the rest through zero weight arcs, in passes until every reached node is in the tree
+    std::vector<int> pending;
+    for (int node = 0; node < numNodes; node++) {
+        if (node != startNode && result.distance[node] != Unreachable && predecessor[node] == -1) {
+            pending.push_back(node);
+        }
+    }
+    while (!pending.empty()) {
+        std::vector<int> unjoined;
+        for (int node : pending) {
+            const Arc *best = nullptr;
+            for (const Arc &arc : graph.inArcs(node)) {
+                const bool joined = arc.node == startNode || predecessor[arc.node] != -1;
+                if (arc.weight == 0 && joined && result.distance[arc.node] == result.distance[node] && precedes(arc, best)) {
+                    best = &arc;
+                }
+            }
+            if (!best) {
+                unjoined.push_back(node);
+            } else {
+                predecessor[node] = best->node;
+                predecessorEdge[node] = best->edge;
+            }
+        }
+        if (unjoined.size() == pending.size()) {
+            break; // Cannot happen with correct distances, but never loop forever
+        }
+        pending.swap(unjoined);
+    }
+}
+
+// Runs the search on the shared pool if no other caller holds it
+PathResult deltaSteppingPath(const Graph &graph, int startNode, int endNode) {
+    static WorkStealingPool sharedPool;
+    static std::mutex sharedPoolMutex;
+    std::unique_lock<std::mutex> lock(sharedPoolMutex, std::try_to_lock);
+    DeltaStepping search(lock.owns_lock() ? &sharedPool : nullptr);
+    return pathTo(search.run(graph, startNode), endNode);
+}
@@ -0,0 +1,54 @@
+#ifndef DELTASTEPPING_H
+#define DELTASTEPPING_H
+
+#include "graph.h"
+#include "shortestpath.h"
+#include "workstealingpool.h"
+
+#include <atomic>
+#include <vector>
+
+// Frontiers smaller than this are relaxed on the calling thread, as waking the pool would cost more
+constexpr int ParallelFrontier = 512;
+
+// Delta-stepping single-source shortest paths (Meyer and Sanders). Tentative distances are kept in
+// buckets delta wide. A bucket's nodes are relaxed together over their light arcs, weighing at most
+// delta, until the bucket stops refilling; its nodes are then final, and their heavy arcs are relaxed
+// once. Each round of relaxations is split across the pool, with distances lowered by atomic minimum,
+// so the distances are the same as Dijkstra's whatever the thread count and timing. Predecessors are
+// derived from the final distances, taking the lowest numbered node on a shortest path, so they do not
+// depend on the timing either.
+class DeltaStepping {
+public:
+    explicit DeltaStepping(WorkStealingPool *pool = nullptr, int delta = 0); // delta 0 picks one per graph
+
+    void setDelta(int delta); // Bucket width, 0 to pick one per graph
+    int delta() const; // Bucket width set, 0 if it is picked per graph
+    const SearchResult &run(const Graph &graph, int startNode); // Settles every node reachable from startNode
+
+private:
+    void relax(const Graph &graph, const std::vector<int> &nodes, bool light); // Relaxes the light or heavy arcs of nodes
+    void relaxRange(const Graph &graph, const std::vector<int> &nodes, int first, int last, bool light,
+                    std::vector<int> &improved); // Relaxes the arcs of nodes[first, last), noting the nodes lowered
+    void fillPredecessors(const Graph &graph, int startNode); // Picks a predecessor for every reached node
+
+    WorkStealingPool *pool; // Pool the relaxations are spread over, null to run on the calling thread
+    int requestedDelta; // Bucket width asked for, 0 to pick one per graph
+    int width = 1; // Bucket width of the current run
+    std::vector<std::atomic<int>> distance; // Tentative distances of the current run
+    std::vector<std::vector<int>> buckets; // Nodes by tentative distance / width, reused cyclically
+    std::vector<std::vector<int>> improved; // Nodes each worker lowered in the last round
+    std::vector<int> queuedIn; // Last bucket round each node was taken into, to skip duplicates
+    std::vector<int> settledIn; // Last bucket each node was settled in
+    SearchResult result; // Output of the last run
+};
+
+// Bucket width used when none is given: the largest weight spread over the average number of arcs per
+// node, so a light round touches about one arc per node
+int defaultDelta(const Graph &graph);
+
+// Answers a start -> end query with delta-stepping on a pool shared by the whole process. The pool takes
+// one caller at a time; a caller finding it busy runs the search on its own thread instead of waiting.
+PathResult deltaSteppingPath(const Graph &graph, int startNode, int endNode);
+
+#endif // DELTASTEPPING_H
@@ -0,0 +1,101 @@
+#ifndef GEOMETRY_H
+#define GEOMETRY_H
+
+#include "graph.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Radius of a node circle in scene coordinates
+constexpr double NodeRadius = 15.0;
+
+// Straight line segment between two points
+struct Segment {
+    Point p1;
+    Point p2;
+};
+
+// Straight-line distance between two points
+inline double distance(const Point &a, const Point &b) {
+    return std::hypot(b.x - a.x, b.y - a.y);
+}
+
+// Point at parameter t along a segment, t = 0 at p1 and t = 1 at p2
+inline Point pointAt(const Segment &s, double t) {
+    return Point{s.p1.x + (s.p2.x - s.p1.x) * t, s.p1.y + (s.p2.y - s.p1.y) * t};
+}
+
+// Shortest distance from a point to any point of a segment, collapsed segments act as a point
+inline double distanceToSegment(const Point &p, const Segment &s) {
+    const double dx = s.p2.x - s.p1.x;
+    const double dy = s.p2.y - s.p1.y;
+    const double lengthSquared = dx * dx + dy * dy;
+    if (lengthSquared == 0) {
+        return distance(p, s.p1);
+    }
+    const double t = std::clamp(((p.x - s.p1.x) * dx + (p.y - s.p1.y) * dy) / lengthSquared, 0.0, 1.0);
+    return distance(p, pointAt(s, t));
+}
+
+// Visible part of an edge between two node centres, trimmed by the node radius at both ends.
+// Edges between nodes that overlap collapse to a single point.
+inline Segment edgeSegment(const Point &source, const Point &dest) {
+    double dx = dest.x - source.x;
+    double dy = dest.y - source.y;
+    double length = std::hypot(dx, dy);
+    if (length > 2 * NodeRadius) {
+        Point offset{(dx * NodeRadius) / length, (dy * NodeRadius) / length};
+        return Segment{Point{source.x + offset.x, source.y + offset.y}, Point{dest.x - offset.x, dest.y - offset.y}};
+    }
+    return Segment{source, source};
+}
+
+// Checks if two segments cross within both their lengths. This follows QLineF::intersects returning
+// QLineF::BoundedIntersection exactly, so parallel and degenerate segments never intersect.
+inline bool segmentsIntersect(const Segment &s, const Segment &t) {
+    const Point a{s.p2.x - s.p1.x, s.p2.y - s.p1.y};
+    const Point b{t.p1.x - t.p2.x, t.p1.y - t.p2.y};
+    const Point c{s.p1.x - t.p1.x, s.p1.y - t.p1.y};
+
+    const double denominator = a.y * b.x - a.x * b.y;
+    if (denominator == 0 || !std::isfinite(denominator)) {
+        return false;
+    }
+
+    const double reciprocal = 1 / denominator;
+    const double na = (b.y * c.x - b.x * c.y) * reciprocal;
+    if (na < 0 || na > 1) {
+        return false;
+    }
+
+    const double nb = (a.x * c.y - a.y * c.x) * reciprocal;
+    return nb >= 0 && nb <= 1;
+}
+
+// Checks if any part of a segment lies in the rectangle between two corners, by clipping the segment's
+// parameter range to each side in turn
+inline bool segmentIntersectsRect(const Segment &s, const Point &topLeft, const Point &bottomRight) {
+    const double dx = s.p2.x - s.p1.x;
+    const double dy = s.p2.y - s.p1.y;
+    double t0 = 0;
+    double t1 = 1;
+    const double directions[4] = {-dx, dx, -dy, dy};
+    const double distances[4] = {s.p1.x - topLeft.x, bottomRight.x - s.p1.x, s.p1.y - topLeft.y, bottomRight.y - s.p1.y};
+    for (int side = 0; side < 4; side++) {
+        if (directions[side] == 0) {
+            if (distances[side] < 0) {
+                return false;
+            }
+        } else {
+            const double t = distances[side] / directions[side];
+            if (directions[side] < 0) {
+                t0 = std::max(t0, t);
+            } else {
+                t1 = std::min(t1, t);
+            }
+        }
+    }
+    return t0 <= t1;
+}
+
+#endif // GEOMETRY_H
@@ -0,0 +1,109 @@
+#include "graph.h"
+
+#include <utility>
+
+// Graph constructor takes ownership of the node positions and edge list and builds the adjacency
+Graph::Graph(std::vector<Point> positions, std::vector<GraphEdge> edges)
+    : nodePositions(std::move(positions)), edgeList(std::move(edges))
+{
+    buildAdjacency();
+}
+
+// Returns the number of nodes
+int Graph::nodeCount() const {
+    return int(nodePositions.size());
+}
+
+// Returns the number of edges
+int Graph::edgeCount() const {
+    return int(edgeList.size());
+}
+
+// Returns the largest edge weight
+int Graph::maxWeight() const {
+    return largestWeight;
+}
+
+// Returns the scene position of a node
+const Point &Graph::position(int node) const {
+    return nodePositions[node];
+}
+
+// Returns the scene positions of all nodes
+const std::vector<Point> &Graph::positions() const {
+    return nodePositions;
+}
+
+// Returns the edge record for an edge id
+const GraphEdge &Graph::edge(int id) const {
+    return edgeList[id];
+}
+
+// Returns all edge records
+const std::vector<GraphEdge> &Graph::edges() const {
+    return edgeList;
+}
+
+// Returns the arcs leaving a node
+ArcRange Graph::outArcs(int node) const {
+    const Arc *base = outArcList.data();
+    return ArcRange(base + outOffsets[node], base + outOffsets[node + 1]);
+}
+
+// Returns the arcs arriving at a node
+ArcRange Graph::inArcs(int node) const {
+    const Arc *base = inArcList.data();
+    return ArcRange(base + inOffsets[node], base + inOffsets[node + 1]);
+}
+
+// Returns the first edge that can be traversed from one node to another, or -1 if there is none
+int Graph::findEdge(int from, int to) const {
+    for (const Arc &arc : outArcs(from)) {
+        if (arc.node == to) {
+            return arc.edge;
+        }
+    }
+    return -1;
+}
+
+// Fills the forward and reverse CSR arrays using a counting sort over the edge list
+void Graph::buildAdjacency() {
+    const int numNodes = nodeCount();
+    outOffsets.assign(numNodes + 1, 0);
+    inOffsets.assign(numNodes + 1, 0);
+
+    // Count the arcs leaving and arriving at each node
+    largestWeight = 0;
+    for (const GraphEdge &e : edgeList) {
+        if (e.weight > largestWeight) {
+            largestWeight = e.weight;
+        }
+        outOffsets[e.source + 1]++;
+        inOffsets[e.dest + 1]++;
+        if (!e.directed) {
+            outOffsets[e.dest + 1]++;
+            inOffsets[e.source + 1]++;
+        }
+    }
+
+    // Turn the counts into offsets
+    for (int i = 0; i < numNodes; i++) {
+        outOffsets[i + 1] += outOffsets[i];
+        inOffsets[i + 1] += inOffsets[i];
+    }
+
+    // Scatter the arcs into place, keeping edge id order within each node's run
+    outArcList.resize(outOffsets[numNodes]);
+    inArcList.resize(inOffsets[numNodes]);
+    std::vector<int> outFill(outOffsets.begin(), outOffsets.end() - 1);
+    std::vector<int> inFill(inOffsets.begin(), inOffsets.end() - 1);
+    for (int id = 0; id < edgeCount(); id++) {
+        const GraphEdge &e = edgeList[id];
+        outArcList[outFill[e.source]++] = Arc{e.dest, id, e.weight};
+        inArcList[inFill[e.dest]++] = Arc{e.source, id, e.weight};
+        if (!e.directed) {
+            outArcList[outFill[e.dest]++] = Arc{e.source, id, e.weight};
+            inArcList[inFill[e.source]++] = Arc{e.dest, id, e.weight};
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef GRAPH_H
+#define GRAPH_H
+
+#include <vector>
+
+// Largest weight the quiz generator assigns to an edge, generated weights lie in [1, MaxGeneratedWeight]
+constexpr int MaxGeneratedWeight = 14;
+
+// Position of a node in scene coordinates
+struct Point {
+    double x = 0.0;
+    double y = 0.0;
+};
+
+// Edge record as stored in the graph core, endpoints are dense node ids
+struct GraphEdge {
+    int source = -1; // Source node id
+    int dest = -1; // Destination node id
+    int weight = 0; // Edge weight
+    bool directed = false; // Flag indicating if the edge can only be traversed from source to dest
+};
+
+// A single entry of the compressed sparse row adjacency
+struct Arc {
+    int node; // Node at the other end of the arc
+    int edge; // Id of the edge the arc was built from
+    int weight; // Weight of the edge
+};
+
+// Lightweight view over a contiguous run of arcs
+class ArcRange {
+public:
+    ArcRange(const Arc *first, const Arc *last) : first(first), last(last) {}
+
+    const Arc *begin() const { return first; }
+    const Arc *end() const { return last; }
+    int size() const { return int(last - first); }
+    bool empty() const { return first == last; }
+
+private:
+    const Arc *first, *last;
+};
+
+// Immutable graph with dense integer node ids and CSR adjacency in both directions.
+// Undirected edges appear in the out and in arcs of both endpoints.
+class Graph {
+public:
+    Graph() = default;
+    Graph(std::vector<Point> positions, std::vector<GraphEdge> edges);
+
+    int nodeCount() const; // Number of nodes
+    int edgeCount() const; // Number of edges
+    int maxWeight() const; // Largest edge weight, 0 for a graph without edges
+    const Point &position(int node) const; // Scene position of a node
+    const std::vector<Point> &positions() const; // Scene positions of all nodes
+    const GraphEdge &edge(int id) const; // Edge record for an edge id
+    const std::vector<GraphEdge> &edges() const; // All edge records, indexed by edge id
+    ArcRange outArcs(int node) const; // Arcs that can be traversed leaving the node
+    ArcRange inArcs(int node) const; // Arcs that can be traversed arriving at the node
+    int findEdge(int from, int to) const; // Id of an edge traversable from -> to, or -1
+
+private:
+    void buildAdjacency(); // Helper function to fill the CSR arrays from the edge list
+
+    std::vector<Point> nodePositions; // Node positions indexed by node id
+    std::vector<GraphEdge> edgeList; // Edge records indexed by edge id
+    int largestWeight = 0; // Largest edge weight
+    std::vector<int> outOffsets; // Start of each node's run in outArcList, size nodeCount() + 1
+    std::vector<Arc> outArcList; // Forward arcs grouped by tail node
+    std::vector<int> inOffsets; // Start of each node's run in inArcList, size nodeCount() + 1
+    std::vector<Arc> inArcList; // Reverse arcs grouped by head node
+};
+
+#endif // GRAPH_H
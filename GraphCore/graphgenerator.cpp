@@ -0,0 +1,294 @@
+#include "graphgenerator.h"
+#include "crossinggraph.h"
+#include "kdtree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+
+// GraphGenerator constructor stores the options and the random source shared by all stages
+GraphGenerator::GraphGenerator(const GeneratorConfig &config, Random &random)
+    : config(config), random(random)
+{
+}
+
+// Returns a random number of columns, advanced graphs are wider and large graphs span a scrollable scene
+int GraphGenerator::generateColumnCount() {
+    switch (config.graphType) {
+    case 0:
+        return random.bounded(3, 5);
+    case 1:
+        return random.bounded(4, 7);
+    default:
+        return random.bounded(25, 41);
+    }
+}
+
+// Places a random number of nodes in each column, perturbed slightly so the columns are not perfectly straight
+GraphLayout GraphGenerator::generateNodes(const int numOfColumns) {
+    GraphLayout layout;
+    double xBase = int(config.sceneWidth - 20) / (numOfColumns + 1); // Base x-coordinate for node placement
+
+    for (int i = 0; i < numOfColumns; i++) {
+        double x = xBase * (i + 1);
+
+        // The first and last columns hold the start and end nodes and are kept small
+        int minNodes = (i == 0 || i == (numOfColumns - 1)) ? 1 : 2;
+        int maxNodes = (i == 0 || i == (numOfColumns - 1)) ?
+                           (config.graphType == 0 ? 3 : 4) : (config.graphType == 0 ? 4 : (config.graphType == 1 ? 6 : 17));
+        int nodesInColumn = random.bounded(minNodes, maxNodes);
+
+        double yBase = int(config.sceneHeight - 20) / (nodesInColumn + 1); // Base y-coordinate for the column
+        for (int j = 0; j < nodesInColumn; j++) {
+            double y = yBase * (j + 1);
+            int perturb = random.bounded(-15, 15);
+            layout.positions.push_back(Point{x + perturb, y + perturb});
+            layout.columns.push_back(i);
+        }
+    }
+
+    return layout;
+}
+
+// Joins consecutive nodes into a chain, then gives every node an edge to its nearest node it is not yet joined to.
+// Length-proportional weights draw nothing from the random source and are set once every edge is known.
+void GraphGenerator::generateEdges(GraphLayout &layout) {
+    const int numNodes = int(layout.positions.size());
+    std::unordered_set<uint64_t> joined; // Packed (min id, max id) of every edge added so far
+
+    // Chain through the nodes in generation order
+    for (int i = 0; i < numNodes - 1; i++) {
+        bool directed = generateDirected();
+        int weight = config.proportionalWeights ? 0 : generateWeight();
+        layout.edges.push_back(GraphEdge{i, i + 1, weight, directed});
+        joined.insert(nodePairKey(i, i + 1));
+    }
+    layout.spanningPath = layout.edges;
+
+    const KdTree tree(layout.positions);
+    std::vector<int> excludedFor(numNodes, -1); // Node1 whose search excluded each node
+
+    for (int node1 = 0; node1 < numNodes; node1++) {
+        const Point &origin = layout.positions[node1];
+        excludedFor[node1] = node1;
+        int numExcluded = 1;
+        std::vector<int> neighbours; // Nearest nodes to node1 by (distance, id), fetched in growing batches
+        size_t next = 0; // First entry of neighbours that may still be available
+        int node2 = -1;
+        bool fullGraph = false;
+
+        for (;;) {
+            // Stop once node1 is joined to every other node
+            if (numExcluded == numNodes) {
+                fullGraph = true;
+                break;
+            }
+
+            // Draw a random candidate as before; it only matters when it ties with the nearest node,
+            // but drawing keeps the random sequence, and so every later edge, the same for a seed
+            int candidate;
+            do {
+                candidate = random.bounded(numNodes);
+            } while (excludedFor[candidate] == node1);
+
+            // Move to the nearest node that is still available, preferring the candidate on a tie
+            while (next == neighbours.size() || excludedFor[neighbours[next]] == node1) {
+                if (next == neighbours.size()) {
+                    neighbours = tree.nearest(origin, std::max(4, 2 * int(neighbours.size())), node1);
+                } else {
+                    next++;
+                }
+            }
+            node2 = neighbours[next];
+            if (distance(origin, layout.positions[candidate]) <= distance(origin, layout.positions[node2])) {
+                node2 = candidate;
+            }
+
+            // Exclude node2 and search again if the two are already joined in either direction
+            if (joined.count(nodePairKey(node1, node2)) == 0) {
+                break;
+            }
+            excludedFor[node2] = node1;
+            numExcluded++;
+        }
+
+        // Stop adding edges once a node is joined to every other node
+        if (fullGraph) {
+            break;
+        }
+
+        bool directed = generateDirected();
+        int weight = config.proportionalWeights ? 0 : generateWeight();
+        layout.edges.push_back(GraphEdge{node1, node2, weight, directed});
+        joined.insert(nodePairKey(node1, node2));
+    }
+
+    if (config.proportionalWeights) {
+        weighByLength(layout);
+    }
+}
+
+// Repeatedly removes the edge with the most crossings while that count reaches the limit
+void GraphGenerator::removeEdgesWithHighIntersections(GraphLayout &layout) {
+    // Crossings are found once; removing an edge only lowers the counts of the edges it crossed
+    CrossingGraph crossings(edgeSegments(layout));
+    for (int worstEdge = crossings.mostCrossedEdge();
+         worstEdge != -1 && crossings.crossingCount(worstEdge) >= config.intersectionLimit;
+         worstEdge = crossings.mostCrossedEdge()) {
+        crossings.remove(worstEdge);
+    }
+
+    std::vector<GraphEdge> keptEdges;
+    for (int i = 0; i < int(layout.edges.size()); i++) {
+        if (!crossings.isRemoved(i)) {
+            keptEdges.push_back(layout.edges[i]);
+        }
+    }
+    layout.edges = std::move(keptEdges);
+}
+
+// Removes edges that pass within the clearance distance of a node they do not connect
+void GraphGenerator::removeNodeIntersectingEdges(GraphLayout &layout) {
+    const SpatialGrid nodes = nodeIndex(layout);
+    std::vector<GraphEdge> keptEdges;
+
+    for (const GraphEdge &edge : layout.edges) {
+        const Segment segment = edgeSegment(layout.positions[edge.source], layout.positions[edge.dest]);
+        bool tooClose = false;
+
+        // Only nodes in cells near the segment can be within the clearance distance
+        nodes.forEachNearSegment(segment, config.nodeClearance, [&](int node) {
+            if (node != edge.source && node != edge.dest
+                && distanceToSegment(layout.positions[node], segment) < config.nodeClearance) {
+                tooClose = true;
+            }
+        });
+
+        if (!tooClose) {
+            keptEdges.push_back(edge);
+        }
+    }
+
+    layout.edges = std::move(keptEdges);
+}
+
+// Guarantees the question has an answer of at least two edges without generating another graph. An edge
+// leading straight from the start node to the end node is dropped. The chain edges all lead forwards, so
+// walking the chain and restoring each pruned edge whose head is still out of reach makes every node
+// reachable in turn; the walk stops as soon as the end node is. Graphs with the end already in reach and
+// no such edge are left exactly as they were.
+int GraphGenerator::connectStartToEnd(GraphLayout &layout) {
+    const int numNodes = int(layout.positions.size());
+    if (numNodes < 2) {
+        return 0;
+    }
+    const int startNode = 0;
+    const int endNode = numNodes - 1;
+    layout.edges.erase(std::remove_if(layout.edges.begin(), layout.edges.end(), [&](const GraphEdge &e) {
+        return (e.source == startNode && e.dest == endNode) || (!e.directed && e.source == endNode && e.dest == startNode);
+    }), layout.edges.end());
+
+    // Nodes each node leads to over the kept edges
+    std::vector<std::vector<int>> next(numNodes);
+    for (const GraphEdge &e : layout.edges) {
+        next[e.source].push_back(e.dest);
+        if (!e.directed) {
+            next[e.dest].push_back(e.source);
+        }
+    }
+
+    // Marks everything reachable from a node not reached before
+    std::vector<char> reached(numNodes, 0);
+    std::vector<int> stack;
+    const auto reach = [&](int node) {
+        reached[node] = 1;
+        stack.push_back(node);
+        while (!stack.empty()) {
+            const int current = stack.back();
+            stack.pop_back();
+            for (int neighbour : next[current]) {
+                if (!reached[neighbour]) {
+                    reached[neighbour] = 1;
+                    stack.push_back(neighbour);
+                }
+            }
+        }
+    };
+    reach(startNode);
+
+    // Node i is reachable at step i, so restoring its chain edge reaches node i + 1
+    int restored = 0;
+    for (int i = 0; i < int(layout.spanningPath.size()) && !reached[endNode]; i++) {
+        const GraphEdge &e = layout.spanningPath[i];
+        if (!reached[e.dest]) {
+            layout.edges.push_back(e);
+            next[e.source].push_back(e.dest);
+            reach(e.dest);
+            restored++;
+        }
+    }
+    return restored;
+}
+
+// Counts the other segments that cross the given edge
+int GraphGenerator::countIntersectionsForEdge(int edge, const std::vector<Segment> &segments) const {
+    int intersectionCount = 0;
+    for (int other = 0; other < int(segments.size()); other++) {
+        if (other != edge && segmentsIntersect(segments[edge], segments[other])) {
+            intersectionCount++;
+        }
+    }
+    return intersectionCount;
+}
+
+// Returns the visible segment of every edge in the layout
+std::vector<Segment> GraphGenerator::edgeSegments(const GraphLayout &layout) const {
+    std::vector<Segment> segments;
+    segments.reserve(layout.edges.size());
+    for (const GraphEdge &e : layout.edges) {
+        segments.push_back(edgeSegment(layout.positions[e.source], layout.positions[e.dest]));
+    }
+    return segments;
+}
+
+// Builds a grid over the node positions; cells as wide as the clearance keep segment queries to a thin band of cells
+SpatialGrid GraphGenerator::nodeIndex(const GraphLayout &layout) const {
+    return SpatialGrid(layout.positions, config.nodeClearance);
+}
+
+// Packs an unordered node pair into one key, smaller id in the high half
+uint64_t GraphGenerator::nodePairKey(int a, int b) {
+    return (uint64_t(std::min(a, b)) << 32) | uint32_t(std::max(a, b));
+}
+
+// Decides whether a new edge is directed, advanced graphs have more directed edges
+bool GraphGenerator::generateDirected() {
+    if (!config.directed) {
+        return false;
+    }
+    return config.graphType == 0 ? random.bounded(1, 11) > 7 : random.bounded(1, 11) > 4;
+}
+
+// Picks an edge weight at random
+int GraphGenerator::generateWeight() {
+    return random.bounded(1, MaxGeneratedWeight + 1);
+}
+
+// Weighs every edge, chain included, by its length rounded up to a unit of the longest edge's length over the
+// weight range. The longest edge weighs MaxGeneratedWeight, so the whole range of lengths maps onto the weights
+// without clamping and a longer edge never weighs less than a shorter one.
+void GraphGenerator::weighByLength(GraphLayout &layout) const {
+    const auto length = [&](const GraphEdge &e) { return distance(layout.positions[e.source], layout.positions[e.dest]); };
+    double longest = 0.0;
+    for (const GraphEdge &e : layout.edges) {
+        longest = std::max(longest, length(e));
+    }
+    const double lengthPerWeight = longest / MaxGeneratedWeight;
+    for (std::vector<GraphEdge> *edges : {&layout.edges, &layout.spanningPath}) {
+        for (GraphEdge &e : *edges) {
+            // The margin keeps rounding error from lifting the longest edge past the range
+            const int weight = lengthPerWeight > 0.0 ? int(std::ceil(length(e) / lengthPerWeight - 1e-9)) : 1;
+            e.weight = std::clamp(weight, 1, MaxGeneratedWeight);
+        }
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef GRAPHGENERATOR_H
+#define GRAPHGENERATOR_H
+
+#include "geometry.h"
+#include "graph.h"
+#include "nodelabel.h"
+#include "random.h"
+#include "spatialgrid.h"
+
+#include <cstdint>
+#include <vector>
+
+// What a question asks the student for
+enum class QuizMode {
+    ShortestPath, // The nodes along the shortest path from the start node to the end node
+    Distance, // The length of that path, read off a distance matrix with its entry hidden
+    MultiDestination // The path to the end node, then paths and distances to other nodes of the same graph
+};
+
+// Options that shape a generated quiz graph
+struct GeneratorConfig {
+    int graphType = 0; // 0 for basic graphs, 1 for advanced graphs, 2 for large graphs
+    bool directed = false; // Flag allowing directed edges
+    bool proportionalWeights = false; // Flag making edge weights proportional to edge length
+    double sceneWidth = 771; // Width of the scene the nodes are placed in
+    double sceneHeight = 600; // Height of the scene the nodes are placed in
+    int intersectionLimit = 2; // Edges crossing this many others are pruned
+    double nodeClearance = 40.0; // Edges passing closer than this to another node are pruned
+    LabelStyle labelStyle = LabelStyle::Letters; // How nodes are labelled in answers
+    QuizMode quizMode = QuizMode::ShortestPath; // What the question asks for
+    bool uniqueAnswers = false; // Flag regenerating graphs with more than one shortest path
+};
+
+// A graph under construction, before it is frozen into a Graph
+struct GraphLayout {
+    std::vector<Point> positions; // Node positions indexed by node id
+    std::vector<int> columns; // Column index of each node
+    std::vector<GraphEdge> edges; // Edge list, pruning removes entries
+    std::vector<GraphEdge> spanningPath; // Chain from the start node to the end node, kept aside from pruning
+};
+
+// Headless version of the quiz graph generator: places nodes in columns, joins them with edges
+// and prunes edges that make the drawing hard to read
+class GraphGenerator {
+public:
+    GraphGenerator(const GeneratorConfig &config, Random &random);
+
+    int generateColumnCount(); // Random number of columns for the graph type
+    GraphLayout generateNodes(const int numOfColumns); // Places nodes column by column
+    void generateEdges(GraphLayout &layout); // Adds a chain through all nodes and an edge to each node's nearest neighbour
+    void removeEdgesWithHighIntersections(GraphLayout &layout); // Prunes edges that cross too many others
+    void removeNodeIntersectingEdges(GraphLayout &layout); // Prunes edges that pass too close to other nodes
+    int connectStartToEnd(GraphLayout &layout); // Restores pruned chain edges until the end is reachable, returns how many
+    int countIntersectionsForEdge(int edge, const std::vector<Segment> &segments) const; // Number of segments crossing one edge
+
+    std::vector<Segment> edgeSegments(const GraphLayout &layout) const; // Visible segment of every edge
+    SpatialGrid nodeIndex(const GraphLayout &layout) const; // Grid over the node positions with clearance sized cells
+
+private:
+    bool generateDirected(); // Random edge direction for the graph type
+    int generateWeight(); // Random edge weight
+    void weighByLength(GraphLayout &layout) const; // Scales every weight to its edge's length
+    static uint64_t nodePairKey(int a, int b); // Same key for both directions of a node pair
+
+    GeneratorConfig config; // Generation options
+    Random &random; // Source of randomness for every stage
+};
+
+#endif // GRAPHGENERATOR_H
@@ -0,0 +1,452 @@
+#include "graphimporter.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// Splits a stream into lines, reading it a chunk at a time. A line is a view into the chunk buffer and
+// stays valid until the next call; only a line longer than a whole chunk makes the buffer grow.
+class LineReader {
+public:
+    LineReader(std::istream &in, size_t chunkSize) : in(in), buffer(std::max<size_t>(chunkSize, 1)) {}
+
+    // Moves to the next line, false at the end of the stream
+    bool next(std::string_view &line) {
+        for (;;) {
+            const char *begin = buffer.data() + lineStart;
+            const char *newline = static_cast<const char *>(std::memchr(begin, '\n', filled - lineStart));
+            if (newline || (atEnd && lineStart < filled)) {
+                const char *end = newline ? newline : buffer.data() + filled;
+                line = std::string_view(begin, size_t(end - begin));
+                if (!line.empty() && line.back() == '\r') {
+                    line.remove_suffix(1);
+                }
+                lineStart = newline ? size_t(newline - buffer.data()) + 1 : filled;
+                lineCount++;
+                return true;
+            }
+            if (atEnd) {
+                return false;
+            }
+
+            // Keep the partial line at the front of the buffer and read the next chunk after it
+            const size_t partial = filled - lineStart;
+            std::memmove(buffer.data(), begin, partial);
+            filled = partial;
+            lineStart = 0;
+            if (filled == buffer.size()) {
+                buffer.resize(buffer.size() * 2);
+            }
+            in.read(buffer.data() + filled, std::streamsize(buffer.size() - filled));
+            filled += size_t(in.gcount());
+            atEnd = in.gcount() == 0;
+        }
+    }
+
+    int lineNumber() const { return lineCount; } // Number of the line last returned, counting from 1
+
+private:
+    std::istream &in; // Stream being read
+    std::vector<char> buffer; // Current chunk, starting with the unfinished line of the previous one
+    size_t filled = 0; // Bytes of the buffer holding data
+    size_t lineStart = 0; // Start of the next line in the buffer
+    bool atEnd = false; // Set once the stream has nothing more to read
+    int lineCount = 0; // Lines returned so far
+};
+
+// Parses a decimal number with an optional fraction and exponent. Written out rather than left to strtod,
+// which follows the application's locale and would read "1.5" differently in some of them.
+bool parseNumber(std::string_view text, double &value) {
+    size_t i = 0;
+    const bool negative = !text.empty() && text[0] == '-';
+    if (!text.empty() && (text[0] == '-' || text[0] == '+')) {
+        i++;
+    }
+    double mantissa = 0;
+    int exponent = 0;
+    bool digits = false;
+    for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; i++) {
+        mantissa = mantissa * 10 + (text[i] - '0');
+        digits = true;
+    }
+    if (i < text.size() && text[i] == '.') {
+        for (i++; i < text.size() && text[i] >= '0' && text[i] <= '9'; i++) {
+            mantissa = mantissa * 10 + (text[i] - '0');
+            exponent--;
+            digits = true;
+        }
+    }
+    if (!digits) {
+        return false;
+    }
+    if (i < text.size() && (text[i] == 'e' || text[i] == 'E')) {
+        i++;
+        if (i < text.size() && text[i] == '+') {
+            i++;
+        }
+        int power = 0;
+        const auto [end, error] = std::from_chars(text.data() + i, text.data() + text.size(), power);
+        if (error != std::errc() || end == text.data() + i) {
+            return false;
+        }
+        i = size_t(end - text.data());
+        exponent += power;
+    }
+    if (i != text.size()) {
+        return false;
+    }
+    value = (negative ? -mantissa : mantissa) * std::pow(10.0, exponent);
+    return std::isfinite(value);
+}
+
+// Whitespace or comma separated fields of one line
+class Fields {
+public:
+    explicit Fields(std::string_view line) : rest(line) {}
+
+    // Takes the next field, false if the line has no more
+    bool word(std::string_view &field) {
+        const size_t first = rest.find_first_not_of(" \t,");
+        if (first == std::string_view::npos) {
+            rest = std::string_view();
+            return false;
+        }
+        rest.remove_prefix(first);
+        const size_t last = std::min(rest.find_first_of(" \t,"), rest.size());
+        field = rest.substr(0, last);
+        rest.remove_prefix(last);
+        return true;
+    }
+
+    // Takes the next field as an integer in [min, max]
+    bool integer(long long &value, long long min, long long max) {
+        std::string_view field;
+        if (!word(field)) {
+            return false;
+        }
+        const auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+        return error == std::errc() && end == field.data() + field.size() && value >= min && value <= max;
+    }
+
+    // Takes the next field as a decimal number
+    bool number(double &value) {
+        std::string_view field;
+        return word(field) && parseNumber(field, value);
+    }
+
+    // Returns whether every field has been taken
+    bool atEnd() {
+        std::string_view field;
+        Fields copy = *this;
+        return !copy.word(field);
+    }
+
+private:
+    std::string_view rest; // Part of the line not yet taken
+};
+
+constexpr long long MaxId = std::numeric_limits<int>::max() - 1; // Largest node id an int graph can hold
+constexpr long long MaxWeight = std::numeric_limits<int>::max(); // Largest weight an int graph can hold
+
+// Edges and node count collected while a file streams past
+struct ImportState {
+    std::vector<GraphEdge> edges; // Edges in file order
+    long long nodeCount = 0; // Number of nodes, from the header or the largest id seen
+    std::string error; // First error, prefixed with its line
+
+    // Records an error on the reader's current line and returns false
+    bool fail(const LineReader &reader, const std::string &message) {
+        error = "line " + std::to_string(reader.lineNumber()) + ": " + message;
+        return false;
+    }
+
+    // Adds an edge between zero based ids, dropping loops, which the scene cannot draw
+    bool add(const LineReader &reader, long long source, long long dest, long long weight, bool directed) {
+        if (edges.size() >= size_t(std::numeric_limits<int>::max())) {
+            return fail(reader, "too many edges");
+        }
+        if (source != dest) {
+            edges.push_back(GraphEdge{int(source), int(dest), int(weight), directed});
+        }
+        return true;
+    }
+};
+
+// Returns whether a line holds nothing but whitespace
+bool isBlank(std::string_view line) {
+    return line.find_first_not_of(" \t") == std::string_view::npos;
+}
+
+// Reads DIMACS "p sp n m" and "a u v w" lines; arcs are directed and ids count from 1
+bool readDimacs(LineReader &reader, ImportState &state) {
+    std::string_view line;
+    bool sawProblem = false;
+    while (reader.next(line)) {
+        if (isBlank(line) || line[0] == 'c') {
+            continue;
+        }
+        Fields fields(line);
+        std::string_view kind;
+        fields.word(kind);
+        if (kind == "p") {
+            std::string_view problem;
+            long long n = 0, m = 0;
+            if (sawProblem || !fields.word(problem) || problem != "sp" || !fields.integer(n, 0, MaxId + 1)
+                || !fields.integer(m, 0, std::numeric_limits<int>::max())) {
+                return state.fail(reader, "expected a single \"p sp nodes arcs\" line");
+            }
+            sawProblem = true;
+            state.nodeCount = n;
+            state.edges.reserve(size_t(m));
+        } else if (kind == "a") {
+            long long u = 0, v = 0, w = 0;
+            if (!sawProblem) {
+                return state.fail(reader, "arc before the \"p sp\" line");
+            }
+            if (!fields.integer(u, 1, state.nodeCount) || !fields.integer(v, 1, state.nodeCount)
+                || !fields.integer(w, 0, MaxWeight) || !fields.atEnd()) {
+                return state.fail(reader, "expected \"a source dest weight\" with ids from 1 to the node count");
+            }
+            if (!state.add(reader, u - 1, v - 1, w, true)) {
+                return false;
+            }
+        } else {
+            return state.fail(reader, "unknown line type");
+        }
+    }
+    if (!sawProblem) {
+        return state.fail(reader, "missing \"p sp\" line");
+    }
+    return true;
+}
+
+// Reads "source dest [weight]" lines with zero based ids, skipping # and % comments. Edges weigh 1
+// unless the line gives a weight.
+bool readEdgeList(LineReader &reader, ImportState &state, bool directed) {
+    std::string_view line;
+    while (reader.next(line)) {
+        if (isBlank(line) || line[0] == '#' || line[0] == '%') {
+            continue;
+        }
+        Fields fields(line);
+        long long u = 0, v = 0, w = 1;
+        if (!fields.integer(u, 0, MaxId) || !fields.integer(v, 0, MaxId)
+            || (!fields.atEnd() && !fields.integer(w, 0, MaxWeight)) || !fields.atEnd()) {
+            return state.fail(reader, "expected \"source dest [weight]\" with non-negative ids");
+        }
+        state.nodeCount = std::max(state.nodeCount, std::max(u, v) + 1);
+        if (!state.add(reader, u, v, w, directed)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Reads a MatrixMarket coordinate matrix. Entry (i, j) becomes an edge from node i - 1 to node j - 1,
+// undirected if the matrix is symmetric. Values are rounded to whole weights of at least 1 and pattern
+// matrices weigh every edge 1.
+bool readMatrixMarket(LineReader &reader, ImportState &state) {
+    std::string_view line;
+    if (!reader.next(line)) {
+        return state.fail(reader, "empty file");
+    }
+    Fields banner(line);
+    std::string_view tag, object, layout, field, symmetry;
+    if (!banner.word(tag) || tag != "%%MatrixMarket" || !banner.word(object) || object != "matrix"
+        || !banner.word(layout) || !banner.word(field) || !banner.word(symmetry)) {
+        return state.fail(reader, "expected a \"%%MatrixMarket matrix\" banner");
+    }
+    if (layout != "coordinate") {
+        return state.fail(reader, "only coordinate matrices describe a graph");
+    }
+    if (field != "real" && field != "integer" && field != "pattern") {
+        return state.fail(reader, "unsupported value type");
+    }
+    if (symmetry != "general" && symmetry != "symmetric" && symmetry != "skew-symmetric") {
+        return state.fail(reader, "unsupported symmetry");
+    }
+    const bool pattern = field == "pattern";
+    const bool directed = symmetry == "general";
+
+    // The size line follows the comments
+    long long rows = 0, columns = 0, entries = 0;
+    while (reader.next(line) && (isBlank(line) || line[0] == '%')) {
+    }
+    Fields size(line);
+    if (!size.integer(rows, 0, MaxId + 1) || !size.integer(columns, 0, MaxId + 1)
+        || !size.integer(entries, 0, std::numeric_limits<int>::max()) || !size.atEnd()) {
+        return state.fail(reader, "expected \"rows columns entries\"");
+    }
+    state.nodeCount = std::max(rows, columns);
+    state.edges.reserve(size_t(entries));
+
+    while (reader.next(line)) {
+        if (isBlank(line) || line[0] == '%') {
+            continue;
+        }
+        Fields fields(line);
+        long long i = 0, j = 0;
+        double value = 1;
+        if (!fields.integer(i, 1, rows) || !fields.integer(j, 1, columns) || (!pattern && !fields.number(value))
+            || !fields.atEnd()) {
+            return state.fail(reader, pattern ? "expected \"row column\"" : "expected \"row column value\"");
+        }
+        const double weight = std::min(std::max(std::round(std::fabs(value)), 1.0), double(MaxWeight));
+        if (!state.add(reader, i - 1, j - 1, (long long)weight, directed)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Reads DIMACS "v id x y" coordinate lines for a graph with nodeCount nodes
+bool readCoordinates(LineReader &reader, long long nodeCount, std::vector<Point> &positions, std::string &error) {
+    const auto fail = [&](const std::string &message) {
+        error = "coordinates line " + std::to_string(reader.lineNumber()) + ": " + message;
+        return false;
+    };
+    std::string_view line;
+    std::vector<bool> seen(size_t(nodeCount), false);
+    positions.assign(size_t(nodeCount), Point());
+    long long count = 0;
+    while (reader.next(line)) {
+        if (isBlank(line) || line[0] == 'c' || line[0] == 'p') {
+            continue;
+        }
+        Fields fields(line);
+        std::string_view kind;
+        long long id = 0;
+        Point p;
+        if (!fields.word(kind) || kind != "v" || !fields.integer(id, 1, nodeCount) || !fields.number(p.x)
+            || !fields.number(p.y) || !fields.atEnd()) {
+            return fail("expected \"v id x y\" with an id of a node in the graph");
+        }
+        if (seen[size_t(id - 1)]) {
+            return fail("node given twice");
+        }
+        seen[size_t(id - 1)] = true;
+        positions[size_t(id - 1)] = p;
+        count++;
+    }
+    if (count != nodeCount) {
+        return fail("every node needs a coordinate");
+    }
+    return true;
+}
+
+// Lays the nodes out in rows on a square grid, in id order
+std::vector<Point> gridLayout(int nodeCount, double spacing) {
+    const int columns = std::max(1, int(std::ceil(std::sqrt(double(nodeCount)))));
+    std::vector<Point> positions(static_cast<size_t>(nodeCount));
+    for (int i = 0; i < nodeCount; i++) {
+        positions[i] = Point{(i % columns + 1) * spacing, (i / columns + 1) * spacing};
+    }
+    return positions;
+}
+
+// Scales file coordinates to cover the same area as a grid of the nodes would, with north at the top
+// of the scene and a margin of one spacing around the nodes
+void fitCoordinates(std::vector<Point> &positions, double spacing) {
+    if (positions.empty()) {
+        return;
+    }
+    double minX = positions[0].x, maxX = minX, minY = positions[0].y, maxY = minY;
+    for (const Point &p : positions) {
+        minX = std::min(minX, p.x);
+        maxX = std::max(maxX, p.x);
+        minY = std::min(minY, p.y);
+        maxY = std::max(maxY, p.y);
+    }
+    const double width = maxX - minX;
+    const double height = maxY - minY;
+    const double side = spacing * std::sqrt(double(positions.size()));
+    double scale = 1;
+    if (width > 0 && height > 0) {
+        scale = side / std::sqrt(width * height);
+    } else if (width > 0 || height > 0) {
+        scale = side / std::max(width, height);
+    }
+    for (Point &p : positions) {
+        p = Point{(p.x - minX) * scale + spacing, (maxY - p.y) * scale + spacing};
+    }
+}
+
+} // namespace
+
+// Returns the format matching a file name's extension
+GraphFormat graphFormatForFile(const std::string &fileName) {
+    const size_t dot = fileName.find_last_of('.');
+    std::string extension = dot == std::string::npos ? std::string() : fileName.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) {
+        return char(std::tolower(c));
+    });
+    if (extension == "gr") {
+        return GraphFormat::Dimacs;
+    }
+    if (extension == "mtx") {
+        return GraphFormat::MatrixMarket;
+    }
+    return GraphFormat::EdgeList;
+}
+
+// Opens a graph file, and for DIMACS the coordinate file with the same base name, and imports them
+ImportResult importGraphFile(const std::string &fileName, const ImportOptions &options) {
+    std::ifstream in(fileName, std::ios::binary);
+    if (!in) {
+        ImportResult result;
+        result.error = "could not open " + fileName;
+        return result;
+    }
+    const GraphFormat format = graphFormatForFile(fileName);
+    std::ifstream coordinates;
+    if (format == GraphFormat::Dimacs) {
+        coordinates.open(fileName.substr(0, fileName.size() - 2) + "co", std::ios::binary);
+    }
+    return importGraph(in, format, options, coordinates.is_open() ? &coordinates : nullptr);
+}
+
+// Streams the edges into an edge list, then builds the graph's adjacency from it in one counting sort
+ImportResult importGraph(std::istream &in, GraphFormat format, const ImportOptions &options,
+                         std::istream *coordinates) {
+    ImportResult result;
+    ImportState state;
+    LineReader reader(in, options.chunkSize);
+    bool read = false;
+    switch (format) {
+    case GraphFormat::Dimacs:
+        read = readDimacs(reader, state);
+        break;
+    case GraphFormat::EdgeList:
+        read = readEdgeList(reader, state, options.directed);
+        break;
+    case GraphFormat::MatrixMarket:
+        read = readMatrixMarket(reader, state);
+        break;
+    }
+    if (!read) {
+        result.error = state.error;
+        return result;
+    }
+
+    std::vector<Point> positions;
+    if (coordinates && format == GraphFormat::Dimacs) {
+        LineReader coordinateReader(*coordinates, options.chunkSize);
+        if (!readCoordinates(coordinateReader, state.nodeCount, positions, result.error)) {
+            return result;
+        }
+        fitCoordinates(positions, options.nodeSpacing);
+        result.hasCoordinates = true;
+    } else {
+        positions = gridLayout(int(state.nodeCount), options.nodeSpacing);
+    }
+    result.graph = Graph(std::move(positions), std::move(state.edges));
+    return result;
+}
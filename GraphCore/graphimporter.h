@@ -0,0 +1,46 @@
+#ifndef GRAPHIMPORTER_H
+#define GRAPHIMPORTER_H
+
+#include "graph.h"
+
+#include <cstddef>
+#include <istream>
+#include <string>
+
+// File formats the importer reads
+enum class GraphFormat {
+    Dimacs, // DIMACS shortest path challenge .gr arcs, with optional .co coordinates
+    EdgeList, // One "source dest [weight]" line per edge, zero based ids
+    MatrixMarket // MatrixMarket coordinate matrix, every entry an edge
+};
+
+// Options of an import
+struct ImportOptions {
+    bool directed = true; // Whether edge list edges are directed, the other formats say so themselves
+    double nodeSpacing = 60.0; // Average distance between neighbouring nodes once laid out in the scene
+    size_t chunkSize = size_t(1) << 20; // Bytes read from the file at a time
+};
+
+// Outcome of an import
+struct ImportResult {
+    Graph graph; // Imported graph, empty if the import failed
+    bool hasCoordinates = false; // Set if the positions came from the file rather than a grid layout
+    std::string error; // Why the import failed, empty on success
+
+    bool ok() const { return error.empty(); }
+};
+
+// Format of a file judged by its extension: .gr is DIMACS, .mtx is MatrixMarket and anything else an edge list
+GraphFormat graphFormatForFile(const std::string &fileName);
+
+// Streams a graph out of a file, reading a DIMACS .co file next to a .gr file if there is one. Lines
+// are parsed straight out of fixed size chunks and the edges go straight into the graph's adjacency,
+// so no more than one chunk of the file is ever held in memory.
+ImportResult importGraphFile(const std::string &fileName, const ImportOptions &options = ImportOptions());
+
+// Streams a graph in one of the formats out of a stream, with DIMACS coordinates from a second stream if
+// given. Nodes without coordinates are laid out on a grid; coordinates are scaled to the same spacing.
+ImportResult importGraph(std::istream &in, GraphFormat format, const ImportOptions &options = ImportOptions(),
+                         std::istream *coordinates = nullptr);
+
+#endif // GRAPHIMPORTER_H
@@ -0,0 +1,94 @@
+#include "kdtree.h"
+#include "geometry.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Coordinate of a point along the x (0) or y (1) axis
+double coordinate(const Point &p, int axis) {
+    return axis == 0 ? p.x : p.y;
+}
+
+} // namespace
+
+// KdTree constructor builds the tree over every point
+KdTree::KdTree(const std::vector<Point> &points)
+    : points(points), ids(points.size())
+{
+    for (int i = 0; i < int(ids.size()); i++) {
+        ids[i] = i;
+    }
+    build(0, int(ids.size()), 0);
+}
+
+// Puts the median of the range in the middle and recurses into both halves on the other axis
+void KdTree::build(int first, int last, int axis) {
+    if (last - first <= 1) {
+        return;
+    }
+    const int middle = first + (last - first) / 2;
+    std::nth_element(ids.begin() + first, ids.begin() + middle, ids.begin() + last, [&](int a, int b) {
+        return coordinate(points[a], axis) < coordinate(points[b], axis);
+    });
+    build(first, middle, 1 - axis);
+    build(middle + 1, last, 1 - axis);
+}
+
+// Returns the k nearest points to a point, closest first, lowest id first on ties
+std::vector<int> KdTree::nearest(const Point &point, int k, int skip) const {
+    std::vector<std::pair<double, int>> best; // Max-heap of (distance, id)
+    if (k > 0) {
+        best.reserve(k + 1);
+        search(0, int(ids.size()), 0, point, k, skip, best);
+    }
+    std::sort_heap(best.begin(), best.end());
+
+    std::vector<int> result;
+    result.reserve(best.size());
+    for (const auto &[dist, id] : best) {
+        result.push_back(id);
+    }
+    return result;
+}
+
+// Visits the side of the split containing the point first, then the far side unless every candidate so
+// far is strictly closer than the splitting line
+void KdTree::search(int first, int last, int axis, const Point &point, int k, int skip,
+                    std::vector<std::pair<double, int>> &best) const {
+    if (first >= last) {
+        return;
+    }
+    const int middle = first + (last - first) / 2;
+    const int id = ids[middle];
+
+    if (id != skip) {
+        std::pair<double, int> candidate{distance(point, points[id]), id};
+        if (int(best.size()) < k || candidate < best.front()) {
+            best.push_back(candidate);
+            std::push_heap(best.begin(), best.end());
+            if (int(best.size()) > k) {
+                std::pop_heap(best.begin(), best.end());
+                best.pop_back();
+            }
+        }
+    }
+
+    const double offset = coordinate(point, axis) - coordinate(points[id], axis);
+    const bool lowerFirst = offset < 0;
+    if (lowerFirst) {
+        search(first, middle, 1 - axis, point, k, skip, best);
+    } else {
+        search(middle + 1, last, 1 - axis, point, k, skip, best);
+    }
+
+    // Points at the same distance as the current worst may still win on id, so equality is searched too
+    if (int(best.size()) < k || std::fabs(offset) <= best.front().first * (1 + 1e-12)) {
+        if (lowerFirst) {
+            search(middle + 1, last, 1 - axis, point, k, skip, best);
+        } else {
+            search(first, middle, 1 - axis, point, k, skip, best);
+        }
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef KDTREE_H
+#define KDTREE_H
+
+#include "graph.h"
+
+#include <utility>
+#include <vector>
+
+// Two dimensional k-d tree over a fixed set of points, stored implicitly: the median of every range
+// of the id array splits it on alternating axes.
+class KdTree {
+public:
+    explicit KdTree(const std::vector<Point> &points);
+
+    // Returns the k points nearest to a point, ordered by (distance, id) so ties come out the same on
+    // every platform. The point with id skip is left out. Asking for a larger k returns a longer list
+    // that starts with the shorter one.
+    std::vector<int> nearest(const Point &point, int k, int skip = -1) const;
+
+private:
+    void build(int first, int last, int axis); // Arranges ids[first, last) around its median
+    void search(int first, int last, int axis, const Point &point, int k, int skip,
+                std::vector<std::pair<double, int>> &best) const; // Collects candidates into a max-heap
+
+    std::vector<Point> points; // Indexed points by id
+    std::vector<int> ids; // Point ids in tree order
+};
+
+#endif // KDTREE_H
@@ -0,0 +1,140 @@
+#include "kshortestpaths.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+// Orders candidates by weight, then by edge sequence so ties come out the same on every platform
+bool KShortestPaths::Candidate::operator>(const Candidate &other) const {
+    return distance != other.distance ? distance > other.distance : edges > other.edges;
+}
+
+// KShortestPaths constructor sizes the scratch arrays; nothing is searched until the first call to next
+KShortestPaths::KShortestPaths(const Graph &graph, int startNode, int endNode, const PathResult *firstPath)
+    : graph(graph), startNode(startNode), endNode(endNode),
+      blockedNode(graph.nodeCount(), 0), blockedEdge(graph.edgeCount(), 0), seen(graph.nodeCount(), 0),
+      distance(graph.nodeCount(), 0), parentEdge(graph.nodeCount(), -1)
+{
+    if (firstPath && firstPath->distance != Unreachable) {
+        candidates.push_back(makeCandidate(firstPath->edges));
+    }
+}
+
+// Returns the shortest path not returned yet
+PathResult KShortestPaths::next() {
+    if (!started) {
+        started = true;
+        if (candidates.empty()) {
+            std::vector<int> edges;
+            ++stamp;
+            if (spurPath(startNode, edges)) {
+                candidates.push_back(makeCandidate(std::move(edges)));
+            }
+        }
+    } else if (!found.empty()) {
+        addSpurCandidates(found.back());
+    }
+
+    PathResult result;
+    if (candidates.empty()) {
+        return result;
+    }
+    std::pop_heap(candidates.begin(), candidates.end(), std::greater<Candidate>());
+    found.push_back(std::move(candidates.back()));
+    candidates.pop_back();
+
+    result.edges = found.back().edges;
+    result.distance = found.back().distance;
+    return result;
+}
+
+// Walks a path of edges from the start node, recording the nodes and adding up the weight
+KShortestPaths::Candidate KShortestPaths::makeCandidate(std::vector<int> edges) const {
+    Candidate candidate{0, std::move(edges), {startNode}};
+    int node = startNode;
+    for (int id : candidate.edges) {
+        const GraphEdge &e = graph.edge(id);
+        node = e.source == node ? e.dest : e.source;
+        candidate.nodes.push_back(node);
+        candidate.distance += e.weight;
+    }
+    return candidate;
+}
+
+// Every node of the previous path but the last is a spur node. The prefix up to the spur node is kept;
+// the spur search may not revisit the prefix, nor leave the spur node along an edge that a returned path
+// with the same prefix already takes.
+void KShortestPaths::addSpurCandidates(const Candidate &previous) {
+    for (size_t i = 0; i + 1 < previous.nodes.size(); i++) {
+        ++stamp;
+        const int spurNode = previous.nodes[i];
+        for (size_t j = 0; j < i; j++) {
+            blockedNode[previous.nodes[j]] = stamp;
+        }
+        for (const Candidate &path : found) {
+            if (path.edges.size() > i && std::equal(previous.edges.begin(), previous.edges.begin() + i, path.edges.begin())) {
+                blockedEdge[path.edges[i]] = stamp;
+            }
+        }
+
+        std::vector<int> spurEdges;
+        if (!spurPath(spurNode, spurEdges)) {
+            continue;
+        }
+        std::vector<int> edges(previous.edges.begin(), previous.edges.begin() + i);
+        edges.insert(edges.end(), spurEdges.begin(), spurEdges.end());
+
+        // The same path can be reached from several spur nodes, keep one copy
+        bool known = false;
+        for (const Candidate &candidate : candidates) {
+            known = known || candidate.edges == edges;
+        }
+        if (!known) {
+            candidates.push_back(makeCandidate(std::move(edges)));
+            std::push_heap(candidates.begin(), candidates.end(), std::greater<Candidate>());
+        }
+    }
+}
+
+// Binary heap Dijkstra from the spur node to the end node that skips blocked nodes and edges
+bool KShortestPaths::spurPath(int spurNode, std::vector<int> &edges) {
+    using Entry = std::pair<int, int>; // (distance, node)
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+
+    seen[spurNode] = stamp;
+    distance[spurNode] = 0;
+    parentEdge[spurNode] = -1;
+    queue.push({0, spurNode});
+
+    while (!queue.empty()) {
+        auto [dist, node] = queue.top();
+        queue.pop();
+        if (dist != distance[node]) {
+            continue; // Stale entry
+        }
+        if (node == endNode) {
+            // Follow the parent edges back to the spur node
+            for (int current = endNode; current != spurNode;) {
+                const int id = parentEdge[current];
+                edges.push_back(id);
+                const GraphEdge &e = graph.edge(id);
+                current = e.source == current ? e.dest : e.source;
+            }
+            std::reverse(edges.begin(), edges.end());
+            return true;
+        }
+        for (const Arc &arc : graph.outArcs(node)) {
+            if (blockedNode[arc.node] == stamp || blockedEdge[arc.edge] == stamp) {
+                continue;
+            }
+            const int newDist = dist + arc.weight;
+            if (seen[arc.node] != stamp || newDist < distance[arc.node]) {
+                seen[arc.node] = stamp;
+                distance[arc.node] = newDist;
+                parentEdge[arc.node] = arc.edge;
+                queue.push({newDist, arc.node});
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,53 @@
+#ifndef KSHORTESTPATHS_H
+#define KSHORTESTPATHS_H
+
+#include "graph.h"
+#include "shortestpath.h"
+
+#include <vector>
+
+// Yen's algorithm for the k shortest loopless paths from a start node to an end node. Each new path
+// branches off an earlier one at a spur node: the earlier path's prefix is kept, the edges other known
+// paths take out of that prefix are blocked, and a Dijkstra search that avoids the prefix nodes finishes
+// the path. Paths come out in order of total weight.
+class KShortestPaths {
+public:
+    // Prepares the search. firstPath is the shortest path if the caller already has one, so the
+    // enumeration starts from the same path the question shows.
+    KShortestPaths(const Graph &graph, int startNode, int endNode, const PathResult *firstPath = nullptr);
+
+    // Returns the next shortest path, or a path with no edges and an Unreachable distance once every
+    // loopless path has been returned
+    PathResult next();
+
+private:
+    // A complete path with its node sequence, for branching
+    struct Candidate {
+        int distance; // Total weight
+        std::vector<int> edges; // Edge ids in travel order
+        std::vector<int> nodes; // Nodes in travel order, one more than edges
+
+        bool operator>(const Candidate &other) const;
+    };
+
+    Candidate makeCandidate(std::vector<int> edges) const; // Fills in the node sequence and weight
+    void addSpurCandidates(const Candidate &previous); // Branches every spur node of the latest path
+    bool spurPath(int spurNode, std::vector<int> &edges); // Dijkstra avoiding the blocked nodes and edges
+
+    const Graph &graph; // Graph being searched
+    int startNode; // First node of every path
+    int endNode; // Last node of every path
+    std::vector<Candidate> found; // Paths returned so far, in order
+    std::vector<Candidate> candidates; // Min-heap of paths not yet returned
+    bool started = false; // Set once the first path was returned
+
+    // Scratch state of the spur searches, reset by stamping instead of clearing
+    int stamp = 0; // Current search number
+    std::vector<int> blockedNode; // Search number that blocked each node
+    std::vector<int> blockedEdge; // Search number that blocked each edge
+    std::vector<int> seen; // Search number that labelled each node
+    std::vector<int> distance; // Tentative distance from the spur node
+    std::vector<int> parentEdge; // Edge the best label arrived by
+};
+
+#endif // KSHORTESTPATHS_H
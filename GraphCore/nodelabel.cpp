@@ -0,0 +1,37 @@
+#include "nodelabel.h"
+
+#include <algorithm>
+
+// Letters count in bijective base 26 (A..Z, AA..ZZ, AAA..), numbers are the decimal node id
+void appendNodeLabel(std::string &out, int node, LabelStyle style) {
+    char digits[16];
+    int length = 0;
+    if (style == LabelStyle::Numbers) {
+        unsigned value = unsigned(node);
+        do {
+            digits[length++] = char('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+    } else {
+        unsigned value = unsigned(node) + 1;
+        while (value > 0) {
+            value--;
+            digits[length++] = char('A' + value % 26);
+            value /= 26;
+        }
+    }
+    std::reverse(digits, digits + length);
+    out.append(digits, length);
+}
+
+// Returns the label of a node as its own string
+std::string nodeLabel(int node, LabelStyle style) {
+    std::string label;
+    appendNodeLabel(label, node, style);
+    return label;
+}
+
+// Returns an empty separator while every label is a single letter
+const char *labelSeparator(int nodeCount, LabelStyle style) {
+    return style == LabelStyle::Letters && nodeCount <= SingleLetterLabels ? "" : "-";
+}
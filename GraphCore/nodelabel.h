@@ -0,0 +1,25 @@
+#ifndef NODELABEL_H
+#define NODELABEL_H
+
+#include <string>
+
+// How node ids are shown to the student
+enum class LabelStyle {
+    Letters, // A..Z, then AA, AB, .. like spreadsheet columns
+    Numbers // The node id itself
+};
+
+// Number of nodes that fit single letter labels
+constexpr int SingleLetterLabels = 26;
+
+// Appends the label of a node to a string, so paths can be labelled without a string per node
+void appendNodeLabel(std::string &out, int node, LabelStyle style = LabelStyle::Letters);
+
+// Label shown for a node
+std::string nodeLabel(int node, LabelStyle style = LabelStyle::Letters);
+
+// Text placed between node labels in a path. Single letter labels are run together as they always
+// were; longer labels need a separator to stay readable.
+const char *labelSeparator(int nodeCount, LabelStyle style = LabelStyle::Letters);
+
+#endif // NODELABEL_H
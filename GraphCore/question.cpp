@@ -0,0 +1,352 @@
+#include "question.h"
+#include "kshortestpaths.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+// Nanoseconds elapsed since a starting time
+int64_t elapsedSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Tops the distractors up with the lengths either side of the answer, as the totals of an adding slip
+void addSlipDistances(std::vector<std::string> &distractors, int distance, int count) {
+    for (int offset = 1; int(distractors.size()) < count; offset++) {
+        for (int slip : {distance + offset, distance - offset}) {
+            std::string label = std::to_string(slip);
+            if (slip > 0 && int(distractors.size()) < count
+                && std::find(distractors.begin(), distractors.end(), label) == distractors.end()) {
+                distractors.push_back(std::move(label));
+            }
+        }
+    }
+}
+
+} // namespace
+
+// Adds the timings of another run
+StageTimings &StageTimings::operator+=(const StageTimings &other) {
+    generate += other.generate;
+    prune += other.prune;
+    solve += other.solve;
+    distractors += other.distractors;
+    return *this;
+}
+
+// QuestionPipeline constructor stores the generation options and solver strategy
+QuestionPipeline::QuestionPipeline(const GeneratorConfig &config, SolverMode mode)
+    : config(config), mode(mode)
+{
+}
+
+// Generates the graph for the seed, which connects the start and end nodes by construction, and solves it.
+// The Dijkstra solver builds the shortest path tree and counts the shortest paths in one pass. The other
+// solvers only find the answer, and the tied paths are picked up by the distractor search, unless a
+// unique answer or the tree for further destinations is asked for. When a unique answer is asked for,
+// tied graphs are replaced by the next ones drawn from the seed.
+Question QuestionPipeline::generate(uint64_t seed, StageTimings *timings) const {
+    Random random(seed);
+    GraphGenerator generator(config, random);
+    StageTimings stageTimings;
+    Question question;
+    question.seed = seed;
+    const bool countPaths = mode == SolverMode::Dijkstra || config.uniqueAnswers
+                            || config.quizMode == QuizMode::MultiDestination;
+
+    do {
+        question.attempts++;
+
+        // Generate nodes and edges for the graph
+        auto start = std::chrono::steady_clock::now();
+        GraphLayout layout = generator.generateNodes(generator.generateColumnCount());
+        generator.generateEdges(layout);
+        stageTimings.generate += elapsedSince(start);
+
+        // Remove edges that make the drawing hard to read, then restore any of the chain the path needs
+        start = std::chrono::steady_clock::now();
+        generator.removeEdgesWithHighIntersections(layout);
+        generator.removeNodeIntersectingEdges(layout);
+        generator.connectStartToEnd(layout);
+        stageTimings.prune += elapsedSince(start);
+
+        // Find the shortest path from the first node to the last; the Dijkstra solver answers from the
+        // pass that counts the paths
+        start = std::chrono::steady_clock::now();
+        question.columns = std::move(layout.columns);
+        question.graph = Graph(std::move(layout.positions), std::move(layout.edges));
+        question.startNode = 0;
+        question.endNode = question.graph.nodeCount() - 1;
+        if (mode == SolverMode::Dijkstra) {
+            question.tree = dijkstra(question.graph, question.startNode);
+            question.path = pathTo(question.tree, question.endNode);
+        } else {
+            question.path = shortestPath(question.graph, question.startNode, question.endNode, mode);
+            if (countPaths) {
+                // Another solver may settle a tie differently, so the tree is rerouted along its answer
+                question.tree = dijkstra(question.graph, question.startNode);
+                followPath(question.graph, question.tree, question.startNode, question.path.edges);
+            }
+        }
+        question.optimalPaths = countPaths ? question.tree.pathCount[question.endNode] : 1;
+        stageTimings.solve += elapsedSince(start);
+    } while (config.uniqueAnswers && question.optimalPaths > 1 && question.attempts < MaxUniqueAttempts);
+
+    // Label the answer and find alternative paths for the distractors
+    auto start = std::chrono::steady_clock::now();
+    question.labelStyle = config.labelStyle;
+    question.kind = config.quizMode == QuizMode::Distance ? QuizMode::Distance : QuizMode::ShortestPath;
+    Destination asked = askDestination(question.graph, question.tree, question.startNode, question.endNode,
+                                       question.path, question.kind, config.labelStyle, random);
+    question.answer = std::move(asked.answer);
+    question.optimalAnswers = std::move(asked.optimalAnswers);
+    question.distractors = std::move(asked.distractors);
+    question.choices = std::move(asked.choices);
+    question.answerChoice = asked.answerChoice;
+    question.optimalPaths = asked.optimalPaths;
+
+    // Ask about more nodes of the same graph, reading every answer and its distractors off the tree
+    // already built rather than searching again. The destinations are drawn from the nodes at least two
+    // edges away, and alternate between distances and paths.
+    if (config.quizMode == QuizMode::MultiDestination) {
+        std::vector<int> candidates;
+        for (int node = 0; node < question.graph.nodeCount(); node++) {
+            if (node != question.startNode && node != question.endNode && question.tree.distance[node] != Unreachable
+                && pathEdges(question.tree, node).size() >= 2) {
+                candidates.push_back(node);
+            }
+        }
+        random.shuffle(candidates);
+        candidates.resize(std::min(candidates.size(), size_t(DestinationsPerGraph - 1)));
+        for (int i = 0; i < int(candidates.size()); i++) {
+            const QuizMode destinationKind = i % 2 == 0 ? QuizMode::Distance : QuizMode::ShortestPath;
+            const std::vector<PathResult> nearPaths = sidetrackPaths(question.graph, question.tree, candidates[i]);
+            question.destinations.push_back(askDestination(question.graph, question.tree, question.startNode,
+                                                           candidates[i], pathTo(question.tree, candidates[i]),
+                                                           destinationKind, config.labelStyle, random, &nearPaths));
+        }
+    }
+    stageTimings.distractors += elapsedSince(start);
+
+    if (timings) {
+        *timings += stageTimings;
+    }
+    return question;
+}
+
+// Distance questions take the lengths of other paths as distractors, and path questions the labels of
+// the next shortest paths. Without a counting tree, the paths tied with the answer are taken from the
+// distractor search, which meets them all before any longer path. The answer is slotted in among the
+// shuffled distractors at a random position.
+Destination askDestination(const Graph &graph, const SearchResult &tree, int startNode, int endNode,
+                           const PathResult &path, QuizMode kind, LabelStyle style, Random &random,
+                           const std::vector<PathResult> *nearPaths) {
+    Destination destination;
+    destination.endNode = endNode;
+    destination.kind = kind;
+    destination.path = path;
+    const bool counted = !tree.pathCount.empty();
+    destination.optimalPaths = counted ? tree.pathCount[endNode] : 1;
+    if (kind == QuizMode::Distance) {
+        destination.answer = std::to_string(path.distance);
+        destination.optimalAnswers = {destination.answer};
+        if (nearPaths) {
+            for (const PathResult &near : *nearPaths) {
+                std::string label = std::to_string(near.distance);
+                if (int(destination.distractors.size()) < DistractorCount && near.distance != path.distance
+                    && std::find(destination.distractors.begin(), destination.distractors.end(), label)
+                           == destination.distractors.end()) {
+                    destination.distractors.push_back(std::move(label));
+                }
+            }
+            addSlipDistances(destination.distractors, path.distance, DistractorCount);
+        } else {
+            int ties = 0;
+            destination.distractors = nearOptimalDistances(graph, path, startNode, endNode, DistractorCount, &ties);
+            if (!counted) {
+                destination.optimalPaths += ties;
+            }
+        }
+    } else {
+        destination.answer = pathLabel(graph, startNode, path.edges, style);
+        destination.optimalAnswers = {destination.answer};
+        std::vector<std::string> tied;
+        if (counted && destination.optimalPaths > 1) {
+            for (const std::vector<int> &edges : tiedPaths(graph, tree, endNode, MaxTiedAnswers)) {
+                tied.push_back(pathLabel(graph, startNode, edges, style));
+            }
+        }
+        if (nearPaths) {
+            for (const PathResult &near : *nearPaths) {
+                if (int(destination.distractors.size()) < DistractorCount && near.distance != path.distance) {
+                    std::string label = pathLabel(graph, startNode, near.edges, style);
+                    if (std::find(destination.distractors.begin(), destination.distractors.end(), label)
+                        == destination.distractors.end()) {
+                        destination.distractors.push_back(std::move(label));
+                    }
+                }
+            }
+        } else {
+            destination.distractors = nearOptimalPaths(graph, path, startNode, endNode, DistractorCount, style,
+                                                       counted ? nullptr : &tied);
+            if (!counted) {
+                destination.optimalPaths += int(tied.size());
+            }
+        }
+        for (std::string &label : tied) {
+            if (int(destination.optimalAnswers.size()) < MaxTiedAnswers
+                && std::find(destination.optimalAnswers.begin(), destination.optimalAnswers.end(), label)
+                       == destination.optimalAnswers.end()) {
+                destination.optimalAnswers.push_back(std::move(label));
+            }
+        }
+    }
+
+    destination.choices = destination.distractors;
+    random.shuffle(destination.choices);
+    destination.answerChoice = random.bounded(int(destination.choices.size()) + 1);
+    destination.choices.insert(destination.choices.begin() + destination.answerChoice, destination.answer);
+    return destination;
+}
+
+// Follows a path edge by edge from the start node, collecting the label of each node reached
+std::string pathLabel(const Graph &graph, int startNode, const std::vector<int> &edges, LabelStyle style) {
+    const char *separator = labelSeparator(graph.nodeCount(), style);
+    std::string label;
+    appendNodeLabel(label, startNode, style);
+    int node = startNode;
+    for (int id : edges) {
+        const GraphEdge &e = graph.edge(id);
+        node = e.source == node ? e.dest : e.source;
+        label += separator;
+        appendNodeLabel(label, node, style);
+    }
+    return label;
+}
+
+// Takes the next shortest loopless paths after the answer as distractors. Paths that tie with the answer
+// are also correct, so they are skipped, and listed if asked for, up to a limit so graphs with many ties
+// still finish quickly.
+std::vector<std::string> nearOptimalPaths(const Graph &graph, const PathResult &answer, int startNode, int endNode,
+                                          int count, LabelStyle style, std::vector<std::string> *tiedAnswers) {
+    std::vector<std::string> distractors;
+    if (answer.distance == Unreachable) {
+        return distractors;
+    }
+
+    KShortestPaths paths(graph, startNode, endNode, &answer);
+    paths.next(); // The answer itself
+    int ties = 0;
+    while (int(distractors.size()) < count) {
+        PathResult path = paths.next();
+        if (path.distance == Unreachable) {
+            break;
+        }
+        if (path.distance == answer.distance) {
+            if (++ties > MaxSkippedTies) {
+                break;
+            }
+            if (tiedAnswers) {
+                tiedAnswers->push_back(pathLabel(graph, startNode, path.edges, style));
+            }
+            continue;
+        }
+        std::string label = pathLabel(graph, startNode, path.edges, style);
+        if (std::find(distractors.begin(), distractors.end(), label) == distractors.end()) {
+            distractors.push_back(std::move(label));
+        }
+    }
+    return distractors;
+}
+
+// Takes the distinct lengths of the next shortest loopless paths, which are the totals a student gets by
+// following a wrong route. Paths repeating a length already taken count against the same limit as ties.
+// Short of paths, the lengths either side of the answer stand in, as the totals of an adding slip.
+std::vector<std::string> nearOptimalDistances(const Graph &graph, const PathResult &answer, int startNode, int endNode,
+                                              int count, int *ties) {
+    std::vector<std::string> distractors;
+    if (answer.distance == Unreachable) {
+        return distractors;
+    }
+
+    KShortestPaths paths(graph, startNode, endNode, &answer);
+    paths.next(); // The answer itself
+    int skipped = 0;
+    while (int(distractors.size()) < count) {
+        PathResult path = paths.next();
+        if (path.distance == Unreachable) {
+            break;
+        }
+        std::string label = std::to_string(path.distance);
+        if (path.distance == answer.distance
+            || std::find(distractors.begin(), distractors.end(), label) != distractors.end()) {
+            if (++skipped > MaxSkippedTies) {
+                break;
+            }
+            if (ties && path.distance == answer.distance) {
+                (*ties)++;
+            }
+            continue;
+        }
+        distractors.push_back(std::move(label));
+    }
+
+    addSlipDistances(distractors, answer.distance, count);
+    return distractors;
+}
+
+// Walks the answer's nodes from the end back and tries every in-arc off the tree. The path to the arc's
+// tail must not touch the rest of the answer, which it would rejoin, so the furthest answer node on each
+// tree path is worked out once and shared by the nodes below it.
+std::vector<PathResult> sidetrackPaths(const Graph &graph, const SearchResult &tree, int endNode) {
+    std::vector<PathResult> paths;
+    if (tree.distance[endNode] == Unreachable) {
+        return paths;
+    }
+
+    // Position of each node along the answer, -1 off it
+    const std::vector<int> answer = pathEdges(tree, endNode);
+    std::vector<int> position(graph.nodeCount(), -1);
+    int node = endNode;
+    for (int i = int(answer.size()); i >= 0; i--) {
+        position[node] = i;
+        if (i > 0) {
+            node = tree.predecessor[node];
+        }
+    }
+
+    // Furthest answer position on the tree path to a node, filled in on first use
+    constexpr int Unknown = -2;
+    std::vector<int> furthest(graph.nodeCount(), Unknown);
+    std::vector<int> chain;
+    auto furthestOnPath = [&](int tail) {
+        for (int up = tail; up != -1 && furthest[up] == Unknown; up = tree.predecessor[up]) {
+            chain.push_back(up);
+        }
+        for (; !chain.empty(); chain.pop_back()) {
+            const int parent = tree.predecessor[chain.back()];
+            furthest[chain.back()] = std::max(position[chain.back()], parent == -1 ? -1 : furthest[parent]);
+        }
+        return furthest[tail];
+    };
+
+    node = endNode;
+    for (int i = int(answer.size()); i > 0; i--, node = tree.predecessor[node]) {
+        for (const Arc &arc : graph.inArcs(node)) {
+            if (arc.edge == tree.predecessorEdge[node] || tree.distance[arc.node] == Unreachable
+                || furthestOnPath(arc.node) >= i) {
+                continue;
+            }
+            PathResult path;
+            path.distance = tree.distance[arc.node] + arc.weight + tree.distance[endNode] - tree.distance[node];
+            path.edges = pathEdges(tree, arc.node);
+            path.edges.push_back(arc.edge);
+            path.edges.insert(path.edges.end(), answer.begin() + i, answer.end());
+            paths.push_back(std::move(path));
+        }
+    }
+    std::stable_sort(paths.begin(), paths.end(),
+                     [](const PathResult &a, const PathResult &b) { return a.distance < b.distance; });
+    return paths;
+}
@@ -0,0 +1,115 @@
+#ifndef QUESTION_H
+#define QUESTION_H
+
+#include "graph.h"
+#include "graphgenerator.h"
+#include "nodelabel.h"
+#include "shortestpath.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Number of wrong answers offered next to the correct one
+constexpr int DistractorCount = 4;
+
+// Paths as short as the answer skipped while looking for distractors before giving up
+constexpr int MaxSkippedTies = 16;
+
+// Paths as short as the answer listed as correct answers, the rest are only counted
+constexpr int MaxTiedAnswers = 16;
+
+// Graphs generated for a question asking for a unique answer before a tied one is accepted anyway
+constexpr int MaxUniqueAttempts = 16;
+
+// Questions asked on each graph in the multi-destination mode, the one about the end node included
+constexpr int DestinationsPerGraph = 4;
+
+// One question about a node reached from the start node, answered from the shortest path tree
+struct Destination {
+    int endNode = 0; // Node the question asks about
+    QuizMode kind = QuizMode::ShortestPath; // Whether the path or only its length is asked for
+    PathResult path; // Shortest path from the start node
+    int optimalPaths = 1; // Number of shortest paths to the node
+    std::string answer; // Node labels along the path, or its length
+    std::vector<std::string> optimalAnswers; // Every answer counted as correct, the answer first
+    std::vector<std::string> distractors; // Strictly longer paths after the answer, or their lengths
+    std::vector<std::string> choices; // Answer and distractors in the order they are offered
+    int answerChoice = 0; // Position of the answer in choices
+};
+
+// A fully generated quiz question, independent of any scene items
+struct Question {
+    uint64_t seed = 0; // Seed the question was generated from
+    Graph graph; // Pruned graph shown to the student
+    std::vector<int> columns; // Column index of each node
+    int startNode = 0; // Node the path starts at
+    int endNode = 0; // Node the path ends at
+    PathResult path; // Correct shortest path
+    SearchResult tree; // Shortest path tree from the start node, following the correct path to the end node; empty when
+                       // another solver than Dijkstra's answered and no tree was needed
+    LabelStyle labelStyle = LabelStyle::Letters; // How the nodes are labelled
+    QuizMode kind = QuizMode::ShortestPath; // Whether the path or only its length is asked for, in any quiz mode
+    std::string answer; // Node labels along the shortest path, or its length in distance mode
+    int optimalPaths = 1; // Number of shortest paths from the start node to the end node, above 1 if the question is ambiguous;
+                          // counted up to MaxSkippedTies + 1 without a tree
+    std::vector<std::string> optimalAnswers; // Every answer counted as correct, the answer first; the tied paths in path mode
+    std::vector<std::string> distractors; // Next shortest paths after the answer, strictly longer than it, or their lengths
+    std::vector<std::string> choices; // Answer and distractors in the order they are offered
+    int answerChoice = 0; // Position of the answer in choices
+    std::vector<Destination> destinations; // Further questions on the same graph in the multi-destination mode
+    int attempts = 0; // Number of graphs generated for the question, more than 1 only when a unique answer was asked for
+};
+
+// Wall-clock time spent in each pipeline stage, in nanoseconds
+struct StageTimings {
+    int64_t generate = 0; // Node and edge generation
+    int64_t prune = 0; // Intersection and clearance pruning
+    int64_t solve = 0; // Building the adjacency and finding the shortest path
+    int64_t distractors = 0; // Labelling the answer and finding alternative paths
+
+    StageTimings &operator+=(const StageTimings &other);
+};
+
+// Runs the generate -> prune -> solve -> distractor pipeline without touching any widgets. Every random
+// choice, down to the order of the answer options, comes from the question's seed.
+class QuestionPipeline {
+public:
+    QuestionPipeline(const GeneratorConfig &config, SolverMode mode);
+
+    Question generate(uint64_t seed, StageTimings *timings = nullptr) const; // Generates the question for a seed
+
+private:
+    GeneratorConfig config; // Generation options
+    SolverMode mode; // Strategy used to find the correct path
+};
+
+// Asks about one node of a solved graph: labels the answer, lists the paths tied with it from the tree,
+// finds the distractors and shuffles the choices with the question's random source. The distractors are
+// taken from nearPaths, shortest first, if given, or else searched for.
+Destination askDestination(const Graph &graph, const SearchResult &tree, int startNode, int endNode,
+                           const PathResult &path, QuizMode kind, LabelStyle style, Random &random,
+                           const std::vector<PathResult> *nearPaths = nullptr);
+
+// Labels of the nodes along a path of edges leaving startNode
+std::string pathLabel(const Graph &graph, int startNode, const std::vector<int> &edges,
+                      LabelStyle style = LabelStyle::Letters);
+
+// Labels of up to count next shortest loopless paths, all strictly longer than the answer. The labels of
+// the other paths as short as the answer go to tiedAnswers if given.
+std::vector<std::string> nearOptimalPaths(const Graph &graph, const PathResult &answer, int startNode, int endNode,
+                                          int count, LabelStyle style = LabelStyle::Letters,
+                                          std::vector<std::string> *tiedAnswers = nullptr);
+
+// Lengths of the next shortest loopless paths, all strictly longer than the answer, topped up with the
+// lengths closest to the answer's when the graph has too few distinct paths. The other paths as short as
+// the answer are counted in ties if given.
+std::vector<std::string> nearOptimalDistances(const Graph &graph, const PathResult &answer, int startNode, int endNode,
+                                              int count, int *ties = nullptr);
+
+// Loopless paths that leave the tree's path to the end node by a single arc, shortest first. The tree
+// path to the arc's tail is followed by the arc and the rest of the tree's path, so they are read off
+// the tree without another search.
+std::vector<PathResult> sidetrackPaths(const Graph &graph, const SearchResult &tree, int endNode);
+
+#endif // QUESTION_H
@@ -0,0 +1,266 @@
+#include "questionbank.h"
+
+#include <cstring>
+#include <limits>
+
+namespace {
+
+// Rounds a byte count up to the next multiple of 8
+uint64_t alignTo8(uint64_t bytes) {
+    return (bytes + 7) & ~uint64_t(7);
+}
+
+} // namespace
+
+// Returns the label of an answer option, a slice of the record's text
+std::string_view BankRecord::choice(int i) const {
+    const uint32_t begin = i == 0 ? 0 : choiceEnds[i - 1];
+    return std::string_view(text + begin, choiceEnds[i] - begin);
+}
+
+// QuestionBankView constructor checks the header and locates the index. Records are only checked
+// when they are asked for, so opening a bank costs the same however many questions it holds.
+QuestionBankView::QuestionBankView(const unsigned char *data, size_t size)
+    : data(data), size(size)
+{
+    BankHeader header;
+    if (!data || size < sizeof(header)) {
+        return;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, QuestionBankMagic, sizeof(header.magic)) != 0 || header.version != QuestionBankVersion
+        || header.indexOffset % 8 != 0 || header.indexOffset < sizeof(header) || header.indexOffset > size
+        || (size - header.indexOffset) / sizeof(uint64_t) < header.questionCount
+        || header.questionCount > uint32_t(std::numeric_limits<int>::max())) {
+        return;
+    }
+    recordOffsets = reinterpret_cast<const uint64_t *>(data + header.indexOffset);
+    count = int(header.questionCount);
+}
+
+// Returns whether the header and index are intact
+bool QuestionBankView::isValid() const {
+    return recordOffsets != nullptr;
+}
+
+// Returns the number of questions in the bank
+int QuestionBankView::questionCount() const {
+    return count;
+}
+
+// Points the record's arrays into the bank, leaving the record invalid if any of them would run past the end
+BankRecord QuestionBankView::record(int n) const {
+    BankRecord record;
+    if (n < 0 || n >= count) {
+        return record;
+    }
+    const uint64_t offset = recordOffsets[n];
+    if (offset % 8 != 0 || offset < sizeof(BankHeader) || offset > size || size - offset < sizeof(BankRecordHeader)) {
+        return record;
+    }
+
+    const BankRecordHeader *header = reinterpret_cast<const BankRecordHeader *>(data + offset);
+    const uint64_t nodesOffset = offset + sizeof(BankRecordHeader);
+    const uint64_t edgesOffset = nodesOffset + uint64_t(header->nodeCount) * sizeof(BankNode);
+    const uint64_t pathOffset = edgesOffset + uint64_t(header->edgeCount) * sizeof(BankEdge);
+    const uint64_t choicesOffset = pathOffset + uint64_t(header->pathLength) * sizeof(uint32_t);
+    const uint64_t textOffset = choicesOffset + uint64_t(header->choiceCount) * sizeof(uint32_t);
+    if (textOffset + header->textSize > size) {
+        return record;
+    }
+
+    // Choice labels must lie within the text, in order
+    const uint32_t *choiceEnds = reinterpret_cast<const uint32_t *>(data + choicesOffset);
+    uint32_t previousEnd = 0;
+    for (uint32_t i = 0; i < header->choiceCount; i++) {
+        if (choiceEnds[i] < previousEnd || choiceEnds[i] > header->textSize) {
+            return record;
+        }
+        previousEnd = choiceEnds[i];
+    }
+
+    record.header = header;
+    record.nodes = reinterpret_cast<const BankNode *>(data + nodesOffset);
+    record.edges = reinterpret_cast<const BankEdge *>(data + edgesOffset);
+    record.pathEdges = reinterpret_cast<const uint32_t *>(data + pathOffset);
+    record.choiceEnds = choiceEnds;
+    record.text = reinterpret_cast<const char *>(data + textOffset);
+    return record;
+}
+
+// Builds a full question from its record. A record with out of range node or edge ids gives an
+// empty question, with no nodes.
+Question QuestionBankView::question(int n) const {
+    Question question;
+    const BankRecord record = this->record(n);
+    if (!record.isValid()) {
+        return question;
+    }
+    const BankRecordHeader &header = *record.header;
+    const int nodeCount = int(header.nodeCount);
+    const int edgeCount = int(header.edgeCount);
+    if (header.startNode < 0 || header.startNode >= nodeCount || header.endNode < 0 || header.endNode >= nodeCount
+        || header.answerChoice < 0 || uint32_t(header.answerChoice) >= header.choiceCount
+        || (header.kind != uint8_t(QuizMode::ShortestPath) && header.kind != uint8_t(QuizMode::Distance))) {
+        return question;
+    }
+
+    std::vector<Point> positions(nodeCount);
+    question.columns.resize(nodeCount);
+    for (int i = 0; i < nodeCount; i++) {
+        positions[i] = Point{record.nodes[i].x, record.nodes[i].y};
+        question.columns[i] = record.nodes[i].column;
+    }
+    std::vector<GraphEdge> edges(edgeCount);
+    for (int i = 0; i < edgeCount; i++) {
+        const BankEdge &e = record.edges[i];
+        if (e.source >= header.nodeCount || e.dest >= header.nodeCount) {
+            return Question();
+        }
+        edges[i] = GraphEdge{int(e.source), int(e.dest), int(e.weight), e.directed != 0};
+    }
+    for (uint32_t i = 0; i < header.pathLength; i++) {
+        if (record.pathEdges[i] >= header.edgeCount) {
+            return Question();
+        }
+        question.path.edges.push_back(int(record.pathEdges[i]));
+    }
+
+    question.seed = header.seed;
+    question.graph = Graph(std::move(positions), std::move(edges));
+    question.startNode = header.startNode;
+    question.endNode = header.endNode;
+    question.path.distance = header.distance;
+    question.labelStyle = static_cast<LabelStyle>(header.labelStyle);
+    question.kind = static_cast<QuizMode>(header.kind);
+    question.attempts = header.attempts;
+    question.answerChoice = header.answerChoice;
+    for (uint32_t i = 0; i < header.choiceCount; i++) {
+        question.choices.emplace_back(record.choice(int(i)));
+        if (int(i) != header.answerChoice) {
+            question.distractors.push_back(question.choices.back());
+        }
+    }
+    question.answer = question.choices[header.answerChoice];
+    return question;
+}
+
+// Appends raw items to the file
+template<class T>
+void QuestionBankWriter::write(const T *items, size_t count) {
+    if (count > 0) {
+        out.write(reinterpret_cast<const char *>(items), std::streamsize(sizeof(T) * count));
+        position += sizeof(T) * count;
+    }
+}
+
+// QuestionBankWriter constructor creates the file and writes a placeholder header, which describes an
+// empty bank until finish replaces it
+QuestionBankWriter::QuestionBankWriter(const std::string &fileName)
+    : out(fileName, std::ios::binary | std::ios::trunc)
+{
+    BankHeader header{};
+    std::memcpy(header.magic, QuestionBankMagic, sizeof(header.magic));
+    header.version = QuestionBankVersion;
+    header.indexOffset = sizeof(header);
+    write(&header, 1);
+    pad();
+}
+
+// QuestionBankWriter destructor completes the file if finish was not called
+QuestionBankWriter::~QuestionBankWriter() {
+    finish();
+}
+
+// Returns whether the file could be created and written so far
+bool QuestionBankWriter::isOpen() const {
+    return out.is_open() && out.good();
+}
+
+// Appends one question record
+bool QuestionBankWriter::add(const Question &question, const GeneratorConfig &config) {
+    if (finished || !out.good()) {
+        return false;
+    }
+    const Graph &graph = question.graph;
+    for (const GraphEdge &e : graph.edges()) {
+        if (e.weight < 0 || e.weight > std::numeric_limits<uint16_t>::max()) {
+            return false;
+        }
+    }
+
+    // Join the choice labels into one text block
+    std::vector<uint32_t> choiceEnds;
+    std::string text;
+    for (const std::string &choice : question.choices) {
+        text += choice;
+        choiceEnds.push_back(uint32_t(text.size()));
+    }
+
+    BankRecordHeader header{};
+    header.seed = question.seed;
+    header.sceneWidth = float(config.sceneWidth);
+    header.sceneHeight = float(config.sceneHeight);
+    header.nodeCount = uint32_t(graph.nodeCount());
+    header.edgeCount = uint32_t(graph.edgeCount());
+    header.startNode = question.startNode;
+    header.endNode = question.endNode;
+    header.distance = question.path.distance;
+    header.pathLength = uint32_t(question.path.edges.size());
+    header.choiceCount = uint32_t(question.choices.size());
+    header.answerChoice = question.answerChoice;
+    header.textSize = uint32_t(text.size());
+    header.attempts = question.attempts;
+    header.labelStyle = uint8_t(question.labelStyle);
+    header.kind = uint8_t(question.kind);
+
+    std::vector<BankNode> nodes(graph.nodeCount());
+    for (int i = 0; i < graph.nodeCount(); i++) {
+        nodes[i] = BankNode{float(graph.position(i).x), float(graph.position(i).y), question.columns[i]};
+    }
+    std::vector<BankEdge> edges(graph.edgeCount());
+    for (int i = 0; i < graph.edgeCount(); i++) {
+        const GraphEdge &e = graph.edge(i);
+        edges[i] = BankEdge{uint32_t(e.source), uint32_t(e.dest), uint16_t(e.weight), uint8_t(e.directed), 0};
+    }
+    std::vector<uint32_t> pathEdges(question.path.edges.begin(), question.path.edges.end());
+
+    recordOffsets.push_back(position);
+    write(&header, 1);
+    write(nodes.data(), nodes.size());
+    write(edges.data(), edges.size());
+    write(pathEdges.data(), pathEdges.size());
+    write(choiceEnds.data(), choiceEnds.size());
+    write(text.data(), text.size());
+    pad();
+    return out.good();
+}
+
+// Writes the index after the last record, then rewrites the header to point at it
+bool QuestionBankWriter::finish() {
+    if (finished) {
+        return true;
+    }
+    finished = true;
+    if (!out.is_open()) {
+        return false;
+    }
+
+    BankHeader header{};
+    std::memcpy(header.magic, QuestionBankMagic, sizeof(header.magic));
+    header.version = QuestionBankVersion;
+    header.questionCount = uint32_t(recordOffsets.size());
+    header.indexOffset = position;
+    write(recordOffsets.data(), recordOffsets.size());
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.close();
+    return !out.fail();
+}
+
+// Pads with zeros so the next record or the index starts on an 8 byte boundary
+void QuestionBankWriter::pad() {
+    static const char zeros[8] = {};
+    write(zeros, size_t(alignTo8(position) - position));
+}
@@ -0,0 +1,134 @@
+#ifndef QUESTIONBANK_H
+#define QUESTIONBANK_H
+
+#include "question.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Binary question bank, laid out so a memory mapped file can be read in place. Integers are little
+// endian and every array is aligned to its element size.
+//
+//   BankHeader
+//   for each question, starting on an 8 byte boundary:
+//     BankRecordHeader
+//     BankNode[nodeCount]
+//     BankEdge[edgeCount]
+//     uint32_t pathEdges[pathLength]     edge ids along the answer, in travel order
+//     uint32_t choiceEnds[choiceCount]   end of each choice label in the text
+//     char text[textSize]                choice labels back to back, not null terminated
+//   uint64_t recordOffsets[questionCount], at indexOffset
+//
+// The index comes last so a writer can stream questions without knowing how many there will be.
+
+constexpr char QuestionBankMagic[8] = {'D', 'Q', 'B', 'A', 'N', 'K', '\0', '\1'}; // First bytes of every bank
+constexpr uint32_t QuestionBankVersion = 2; // Layout version, bumped on any change
+
+// Start of the file
+struct BankHeader {
+    char magic[8]; // QuestionBankMagic
+    uint32_t version; // QuestionBankVersion
+    uint32_t questionCount; // Number of records in the index
+    uint64_t indexOffset; // File offset of the record offsets
+};
+
+// Fixed part of a question record
+struct BankRecordHeader {
+    uint64_t seed; // Seed the question was generated from
+    float sceneWidth; // Size of the scene the nodes were placed in
+    float sceneHeight;
+    uint32_t nodeCount; // Number of BankNode entries
+    uint32_t edgeCount; // Number of BankEdge entries
+    int32_t startNode; // Node the path starts at
+    int32_t endNode; // Node the path ends at
+    int32_t distance; // Length of the shortest path
+    uint32_t pathLength; // Number of edges on the shortest path
+    uint32_t choiceCount; // Number of answer options
+    int32_t answerChoice; // Position of the answer among the options
+    uint32_t textSize; // Bytes of choice label text
+    int32_t attempts; // Number of graphs generated for the question
+    uint8_t labelStyle; // LabelStyle of the labels
+    uint8_t kind; // QuizMode the question asks in, ShortestPath or Distance
+    uint8_t padding[2];
+};
+
+// Position and column of a node
+struct BankNode {
+    float x;
+    float y;
+    int32_t column;
+};
+
+// Edge endpoints, weight and direction
+struct BankEdge {
+    uint32_t source;
+    uint32_t dest;
+    uint16_t weight;
+    uint8_t directed;
+    uint8_t padding;
+};
+
+static_assert(sizeof(BankHeader) == 24, "BankHeader must match the file layout");
+static_assert(sizeof(BankRecordHeader) == 64, "BankRecordHeader must match the file layout");
+static_assert(sizeof(BankNode) == 12, "BankNode must match the file layout");
+static_assert(sizeof(BankEdge) == 12, "BankEdge must match the file layout");
+
+// One question as it sits in the bank, pointing into the bank's memory
+struct BankRecord {
+    const BankRecordHeader *header = nullptr; // Null if the record is missing or truncated
+    const BankNode *nodes = nullptr;
+    const BankEdge *edges = nullptr;
+    const uint32_t *pathEdges = nullptr;
+    const uint32_t *choiceEnds = nullptr;
+    const char *text = nullptr;
+
+    bool isValid() const { return header != nullptr; }
+    std::string_view choice(int i) const; // Label of an answer option
+};
+
+// Read-only view over a bank in memory, usually a mapped file. Finding a question is a lookup in
+// the index; nothing is parsed or copied until a question is hydrated.
+class QuestionBankView {
+public:
+    QuestionBankView() = default;
+    QuestionBankView(const unsigned char *data, size_t size);
+
+    bool isValid() const; // Set if the header and index are intact
+    int questionCount() const; // Number of questions in the bank
+    BankRecord record(int n) const; // Record of question n, checked against the end of the data
+    Question question(int n) const; // Copies question n out of the bank, with its graph built
+
+private:
+    const unsigned char *data = nullptr; // Start of the bank
+    size_t size = 0; // Bytes of bank data
+    const uint64_t *recordOffsets = nullptr; // Index, null if the bank is invalid
+    int count = 0; // Number of entries in the index
+};
+
+// Streams questions into a bank file. Records are written as they are added; the index and the final
+// header are written by finish, which the destructor calls if nobody else did.
+class QuestionBankWriter {
+public:
+    explicit QuestionBankWriter(const std::string &fileName);
+    ~QuestionBankWriter();
+
+    bool isOpen() const; // Set if the file could be created
+    bool add(const Question &question, const GeneratorConfig &config); // Appends a question, false on a write error or a weight too large to store
+    bool finish(); // Writes the index and header and closes the file
+
+private:
+    template<class T>
+    void write(const T *items, size_t count); // Appends raw items, advancing the position
+    void pad(); // Pads the file to the next 8 byte boundary
+
+    std::ofstream out; // Bank file
+    std::vector<uint64_t> recordOffsets; // Offset of every record written so far
+    uint64_t position = 0; // Bytes written so far
+    bool finished = false; // Set once the index is written
+};
+
+#endif // QUESTIONBANK_H
@@ -0,0 +1,70 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Seedable random source for the generators. Each generator owns one, so a seed reproduces the same
+// question on every platform and parallel generators never share state. The engine is xoshiro256**,
+// which needs 32 bytes of state and a few instructions per value.
+class Random {
+public:
+    // Expands the seed into the engine state with splitmix64, so nearby seeds give unrelated sequences
+    explicit Random(uint64_t seed = 0) {
+        for (uint64_t &word : state) {
+            seed += 0x9e3779b97f4a7c15;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    // Returns the next raw 64 bit value
+    uint64_t next() {
+        const uint64_t result = rotateLeft(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotateLeft(state[3], 45);
+        return result;
+    }
+
+    // Returns a uniformly distributed value in [0, highest)
+    int bounded(int highest) {
+        // Rejection sampling on the raw engine output, since std::uniform_int_distribution differs between standard libraries
+        const uint64_t range = uint64_t(highest);
+        const uint64_t limit = UINT64_MAX - UINT64_MAX % range;
+        uint64_t value;
+        do {
+            value = next();
+        } while (value >= limit);
+        return int(value % range);
+    }
+
+    // Returns a uniformly distributed value in [lowest, highest)
+    int bounded(int lowest, int highest) {
+        return lowest + bounded(highest - lowest);
+    }
+
+    // Puts the items in a uniformly random order; std::shuffle is avoided for the same reason as above
+    template<class T>
+    void shuffle(std::vector<T> &items) {
+        for (int i = int(items.size()) - 1; i > 0; i--) {
+            std::swap(items[i], items[bounded(i + 1)]);
+        }
+    }
+
+private:
+    static uint64_t rotateLeft(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    uint64_t state[4]; // Engine state, never all zero
+};
+
+#endif // RANDOM_H
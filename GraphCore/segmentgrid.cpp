@@ -0,0 +1,58 @@
+#include "segmentgrid.h"
+
+// SegmentGrid constructor sizes the grid to the segments' bounds and sorts the segment ids into every
+// cell they cross
+SegmentGrid::SegmentGrid(const std::vector<Segment> &segments, double cellSize)
+    : segments(segments), cellSize(cellSize > 0 ? cellSize : 1.0)
+{
+    if (!segments.empty()) {
+        double maxX = segments[0].p1.x;
+        double maxY = segments[0].p1.y;
+        originX = maxX;
+        originY = maxY;
+        for (const Segment &s : segments) {
+            originX = std::min({originX, s.p1.x, s.p2.x});
+            originY = std::min({originY, s.p1.y, s.p2.y});
+            maxX = std::max({maxX, s.p1.x, s.p2.x});
+            maxY = std::max({maxY, s.p1.y, s.p2.y});
+        }
+        columns = int((maxX - originX) / this->cellSize) + 1;
+        rows = int((maxY - originY) / this->cellSize) + 1;
+    }
+
+    // Counting sort of the ids by cell, walking each segment's cells once to count and once to place
+    cellOffsets.assign(size_t(columns) * rows + 1, 0);
+    for (const Segment &s : segments) {
+        forEachCellOf(s, [&](int cell) { cellOffsets[cell + 1]++; });
+    }
+    for (size_t cell = 1; cell < cellOffsets.size(); cell++) {
+        cellOffsets[cell] += cellOffsets[cell - 1];
+    }
+    cellIds.resize(size_t(cellOffsets.back()));
+    std::vector<int> next(cellOffsets.begin(), cellOffsets.end() - 1);
+    for (int id = 0; id < int(segments.size()); id++) {
+        forEachCellOf(segments[id], [&](int cell) { cellIds[next[cell]++] = id; });
+    }
+}
+
+// Returns the number of indexed segments
+int SegmentGrid::segmentCount() const {
+    return int(segments.size());
+}
+
+// Returns an indexed segment
+const Segment &SegmentGrid::segment(int id) const {
+    return segments[id];
+}
+
+// Maps an x coordinate to its cell column, clamping positions outside the grid to the border cells
+int SegmentGrid::column(double x) const {
+    const double c = std::floor((x - originX) / cellSize);
+    return c < 0 ? 0 : (c >= columns ? columns - 1 : int(c));
+}
+
+// Maps a y coordinate to its cell row, clamping positions outside the grid to the border cells
+int SegmentGrid::row(double y) const {
+    const double r = std::floor((y - originY) / cellSize);
+    return r < 0 ? 0 : (r >= rows ? rows - 1 : int(r));
+}
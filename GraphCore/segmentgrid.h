@@ -0,0 +1,88 @@
+#ifndef SEGMENTGRID_H
+#define SEGMENTGRID_H
+
+#include "geometry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Uniform grid over a set of segments for region queries. Each segment is bucketed in every cell it
+// passes through, in one flat array, so a query only looks at the segments crossing the cells its
+// area overlaps, wherever their ends are. A segment is reported once for each of those cells it
+// crosses; callers skip repeats and apply the exact test.
+class SegmentGrid {
+public:
+    SegmentGrid(const std::vector<Segment> &segments, double cellSize);
+
+    int segmentCount() const; // Number of indexed segments
+    const Segment &segment(int id) const; // Indexed segment
+
+    // Calls visit(id) for every segment crossing a cell that overlaps the rectangle between two corners.
+    // Stops early once visit returns false.
+    template<class Visit>
+    void forEachInRect(const Point &topLeft, const Point &bottomRight, Visit &&visit) const;
+
+private:
+    int column(double x) const; // Cell column of an x coordinate, clamped to the grid
+    int row(double y) const; // Cell row of a y coordinate, clamped to the grid
+    template<class Visit>
+    void forEachCellOf(const Segment &segment, Visit &&visit) const; // Calls visit(cell) for the cells a segment crosses
+
+    std::vector<Segment> segments; // Indexed segments by id
+    double originX = 0; // Left edge of the grid
+    double originY = 0; // Top edge of the grid
+    double cellSize; // Width and height of a cell
+    int columns = 1; // Number of cell columns
+    int rows = 1; // Number of cell rows
+    std::vector<int> cellOffsets; // Start of each cell's ids in cellIds, one extra entry at the end
+    std::vector<int> cellIds; // Segment ids grouped by cell
+};
+
+template<class Visit>
+void SegmentGrid::forEachInRect(const Point &topLeft, const Point &bottomRight, Visit &&visit) const {
+    const int lastRow = row(bottomRight.y);
+    const int firstColumn = column(topLeft.x);
+    const int lastColumn = column(bottomRight.x);
+    for (int y = row(topLeft.y); y <= lastRow; y++) {
+        const int first = cellOffsets[y * columns + firstColumn];
+        const int last = cellOffsets[y * columns + lastColumn + 1];
+        for (int i = first; i < last; i++) {
+            if (!visit(cellIds[i])) {
+                return;
+            }
+        }
+    }
+}
+
+// Clips the segment to each row of cells it spans, as SpatialGrid::forEachNearSegment does
+template<class Visit>
+void SegmentGrid::forEachCellOf(const Segment &segment, Visit &&visit) const {
+    const double r = 1e-9; // Slack so rounding never drops a cell the segment touches
+    const double dx = segment.p2.x - segment.p1.x;
+    const double dy = segment.p2.y - segment.p1.y;
+    const int firstRow = row(std::min(segment.p1.y, segment.p2.y) - r);
+    const int lastRow = row(std::max(segment.p1.y, segment.p2.y) + r);
+
+    for (int y = firstRow; y <= lastRow; y++) {
+        double t0 = 0;
+        double t1 = 1;
+        if (dy != 0) {
+            const double tTop = (originY + y * cellSize - r - segment.p1.y) / dy;
+            const double tBottom = (originY + (y + 1) * cellSize + r - segment.p1.y) / dy;
+            t0 = std::max(0.0, std::min(tTop, tBottom));
+            t1 = std::min(1.0, std::max(tTop, tBottom));
+            if (t0 > t1) {
+                continue;
+            }
+        }
+        const double x0 = segment.p1.x + dx * t0;
+        const double x1 = segment.p1.x + dx * t1;
+        const int lastColumn = column(std::max(x0, x1) + r);
+        for (int x = column(std::min(x0, x1) - r); x <= lastColumn; x++) {
+            visit(y * columns + x);
+        }
+    }
+}
+
+#endif // SEGMENTGRID_H
@@ -0,0 +1,213 @@
+#include "shortestpath.h"
+#include "deltastepping.h"
+#include "geometry.h"
+
+#include <cmath>
+
+// Picks the bucket queue engine for generated graphs and the radix heap engine for anything heavier
+SearchResult dijkstra(const Graph &graph, int startNode) {
+    if (graph.maxWeight() <= MaxGeneratedWeight) {
+        DijkstraEngine<MaxGeneratedWeight> engine;
+        return engine.run(graph, startNode);
+    }
+    DijkstraEngine<> engine;
+    return engine.run(graph, startNode);
+}
+
+// Backtracks from the end node through the predecessor edges, one step per edge
+std::vector<int> pathEdges(const SearchResult &result, int endNode) {
+    std::vector<int> path;
+    for (int node = endNode; result.predecessor[node] != -1; node = result.predecessor[node]) {
+        path.push_back(result.predecessorEdge[node]);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+// Copies the distance, search size and path count, and backtracks the path if there is one
+PathResult pathTo(const SearchResult &result, int endNode) {
+    PathResult path;
+    path.distance = result.distance[endNode];
+    path.settled = result.settled;
+    path.pathCount = result.pathCount.empty() ? 0 : result.pathCount[endNode];
+    if (path.distance != Unreachable) {
+        path.edges = pathEdges(result, endNode);
+    }
+    return path;
+}
+
+// Points each node on the path at the node before it. Every prefix of a shortest path is a shortest
+// path, so the tree stays a shortest path tree, and the nodes on the path lead only back along it.
+void followPath(const Graph &graph, SearchResult &result, int startNode, const std::vector<int> &edges) {
+    int node = startNode;
+    for (int id : edges) {
+        const GraphEdge &e = graph.edge(id);
+        const int next = e.source == node ? e.dest : e.source;
+        result.predecessor[next] = node;
+        result.predecessorEdge[next] = id;
+        node = next;
+    }
+}
+
+// Walks back from the end node over the tight in-arcs depth first, so each path is completed before the
+// next is started and the walk stops at the limit. Nodes on the current path are skipped, which keeps
+// zero weight cycles from looping.
+std::vector<std::vector<int>> tiedPaths(const Graph &graph, const SearchResult &result, int endNode, int limit) {
+    std::vector<std::vector<int>> paths;
+    if (limit <= 0 || result.distance[endNode] == Unreachable) {
+        return paths;
+    }
+
+    std::vector<std::pair<int, int>> stack{{endNode, 0}}; // (node, next in-arc to try) back from the end node
+    std::vector<int> edges; // Edge taken into each stacked node but the first, end first
+    std::vector<char> onPath(graph.nodeCount(), 0);
+    onPath[endNode] = 1;
+    while (!stack.empty() && int(paths.size()) < limit) {
+        auto &[node, next] = stack.back();
+        const ArcRange arcs = graph.inArcs(node);
+
+        // The start node is the only reached node without a predecessor
+        if (result.predecessor[node] == -1 || next == int(arcs.size())) {
+            if (result.predecessor[node] == -1) {
+                paths.emplace_back(edges.rbegin(), edges.rend());
+            }
+            onPath[node] = 0;
+            stack.pop_back();
+            if (!edges.empty()) {
+                edges.pop_back();
+            }
+            continue;
+        }
+
+        const Arc &arc = arcs.begin()[next++];
+        if (!onPath[arc.node] && result.distance[arc.node] != Unreachable
+            && result.distance[arc.node] + arc.weight == result.distance[node]) {
+            onPath[arc.node] = 1;
+            edges.push_back(arc.edge);
+            stack.push_back({arc.node, 0});
+        }
+    }
+    return paths;
+}
+
+// Bidirectional Dijkstra. The forward search follows out-arcs from the start node and the backward search
+// follows in-arcs from the end node, so directed edges are only ever used in their own direction.
+// Whenever an arc reaches a node labelled by the other search, the joined path is a candidate. Once the
+// smallest keys of both queues add up to at least the best candidate, no shorter path can exist.
+PathResult bidirectionalDijkstra(const Graph &graph, int startNode, int endNode) {
+    PathResult result;
+    if (startNode == endNode) {
+        result.distance = 0;
+        return result;
+    }
+
+    using MinQueue = std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<std::pair<int, int>>>;
+    const int numNodes = graph.nodeCount();
+    std::vector<int> distance[2] = {std::vector<int>(numNodes, Unreachable), std::vector<int>(numNodes, Unreachable)};
+    std::vector<int> parentEdge[2] = {std::vector<int>(numNodes, -1), std::vector<int>(numNodes, -1)};
+    std::vector<int> parentNode[2] = {std::vector<int>(numNodes, -1), std::vector<int>(numNodes, -1)};
+    MinQueue queue[2];
+
+    distance[0][startNode] = 0;
+    distance[1][endNode] = 0;
+    queue[0].push({0, startNode});
+    queue[1].push({0, endNode});
+
+    // Best meeting path found so far: forward tree to meetTail, meetEdge, backward tree from meetHead
+    int best = Unreachable;
+    int meetTail = -1, meetEdge = -1, meetHead = -1;
+
+    while (!queue[0].empty() && !queue[1].empty()) {
+        if (best != Unreachable && queue[0].top().first + queue[1].top().first >= best) {
+            break;
+        }
+
+        // Expand the side with the smaller frontier key
+        int side = queue[0].top().first <= queue[1].top().first ? 0 : 1;
+        auto [currDist, currNode] = queue[side].top();
+        queue[side].pop();
+        if (currDist > distance[side][currNode]) {
+            continue;
+        }
+        result.settled++;
+
+        for (const Arc &arc : side == 0 ? graph.outArcs(currNode) : graph.inArcs(currNode)) {
+            int newDist = currDist + arc.weight;
+            if (newDist < distance[side][arc.node]) {
+                distance[side][arc.node] = newDist;
+                parentEdge[side][arc.node] = arc.edge;
+                parentNode[side][arc.node] = currNode;
+                queue[side].push({newDist, arc.node});
+            }
+
+            // Join the two searches across this arc
+            int otherDist = distance[1 - side][arc.node];
+            if (otherDist != Unreachable && newDist + otherDist < best) {
+                best = newDist + otherDist;
+                meetEdge = arc.edge;
+                meetTail = side == 0 ? currNode : arc.node;
+                meetHead = side == 0 ? arc.node : currNode;
+            }
+        }
+    }
+
+    if (best == Unreachable) {
+        return result;
+    }
+    result.distance = best;
+
+    // Walk the forward tree back to the start, then the backward tree on to the end
+    for (int node = meetTail; node != startNode; node = parentNode[0][node]) {
+        result.edges.push_back(parentEdge[0][node]);
+    }
+    std::reverse(result.edges.begin(), result.edges.end());
+    result.edges.push_back(meetEdge);
+    for (int node = meetHead; node != endNode; node = parentNode[1][node]) {
+        result.edges.push_back(parentEdge[1][node]);
+    }
+
+    return result;
+}
+
+// EuclideanHeuristic constructor finds the smallest weight per pixel over all edges of the graph
+EuclideanHeuristic::EuclideanHeuristic(const Graph &graph, int targetNode)
+    : graph(graph), target(graph.position(targetNode))
+{
+    bool first = true;
+    for (const GraphEdge &e : graph.edges()) {
+        double length = distance(graph.position(e.source), graph.position(e.dest));
+        if (length <= 0.0) {
+            continue; // Edges between coincident nodes cover no distance and cannot break the bound
+        }
+        double ratio = e.weight / length;
+        if (first || ratio < scale) {
+            scale = ratio;
+            first = false;
+        }
+    }
+}
+
+// Returns the scaled straight-line distance, rounded down with a small margin so rounding error cannot overestimate
+int EuclideanHeuristic::operator()(int node) const {
+    return int(std::floor(scale * distance(graph.position(node), target) * (1.0 - 1e-9)));
+}
+
+// Returns the weight per pixel used to scale distances
+double EuclideanHeuristic::weightPerPixel() const {
+    return scale;
+}
+
+// Answers a start -> end query with the chosen strategy
+PathResult shortestPath(const Graph &graph, int startNode, int endNode, SolverMode mode) {
+    if (mode == SolverMode::Bidirectional) {
+        return bidirectionalDijkstra(graph, startNode, endNode);
+    }
+    if (mode == SolverMode::AStar) {
+        return aStar(graph, startNode, endNode, EuclideanHeuristic(graph, endNode));
+    }
+    if (mode == SolverMode::DeltaStepping) {
+        return deltaSteppingPath(graph, startNode, endNode);
+    }
+
+    return pathTo(dijkstra(graph, startNode), endNode);
+}
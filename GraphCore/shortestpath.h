@@ -0,0 +1,215 @@
+#ifndef SHORTESTPATH_H
+#define SHORTESTPATH_H
+
+#include "bucketqueue.h"
+#include "graph.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Distance assigned to nodes that cannot be reached from the start node
+constexpr int Unreachable = std::numeric_limits<int>::max();
+
+// Shortest path counts stop growing at this value instead of overflowing
+constexpr int MaxPathCount = std::numeric_limits<int>::max();
+
+// Output of a single-source shortest path search: the shortest path tree from the start node. The edge
+// into each node is kept along with the node it leaves, so the path to any node reads back in one step
+// per edge, over the edges the search actually used.
+struct SearchResult {
+    std::vector<int> distance; // Distance from the start node, Unreachable if not reached
+    std::vector<int> predecessor; // Previous node on the shortest path, -1 for the start node and unreached nodes
+    std::vector<int> predecessorEdge; // Edge id from the previous node, -1 for the start node and unreached nodes
+    std::vector<int> pathCount; // Number of shortest paths from the start node, 0 if not reached; empty if not counted
+    int settled = 0; // Number of nodes settled by the search
+};
+
+// Output of a single start -> end query
+struct PathResult {
+    std::vector<int> edges; // Edge ids along the shortest path in travel order
+    int distance = Unreachable; // Length of the shortest path, Unreachable if there is none
+    int settled = 0; // Number of nodes settled by the search
+    int pathCount = 0; // Number of paths as short as this one, 0 if the solver does not count them
+};
+
+// Search strategy used to answer a start -> end query
+enum class SolverMode {
+    Dijkstra, // Single-source Dijkstra that settles every reachable node
+    Bidirectional, // Forward search over out-arcs meeting a backward search over in-arcs
+    AStar, // Goal-directed search guided by the straight-line distance to the end node
+    DeltaStepping, // Bucketed single-source search with each bucket's relaxations spread over threads
+};
+
+// A* heuristic that always returns zero, which makes A* settle nodes exactly like Dijkstra
+struct ZeroHeuristic {
+    int operator()(int) const { return 0; }
+};
+
+// A* heuristic that scales the straight-line distance to the target by the smallest weight per pixel of
+// any edge. Every edge weighs at least that ratio times its length, so the estimate never exceeds the
+// remaining path weight and A* stays exact.
+class EuclideanHeuristic {
+public:
+    EuclideanHeuristic(const Graph &graph, int targetNode);
+
+    int operator()(int node) const; // Lower bound on the path weight from node to the target
+    double weightPerPixel() const; // Scale applied to straight-line distances
+
+private:
+    const Graph &graph; // Graph the node positions come from
+    Point target; // Position of the target node
+    double scale = 0.0; // Smallest weight per pixel over all edges
+};
+
+// Reusable Dijkstra engine. With a positive MaxWeight it runs on Dial's bucket queue and every edge weight
+// must lie in [0, MaxWeight], giving O(E + V * MaxWeight); with MaxWeight = 0 it falls back to a radix heap
+// for unbounded weights. Result and queue storage are kept between runs. In the same pass it counts the
+// shortest paths to every node: an arc that lowers a node's distance hands it the tail's count, one that
+// ties with it adds the tail's count. A node's count is final when it is settled, so the counts are exact
+// when every weight is positive; zero weight arcs between nodes as far away may be missed.
+template <int MaxWeight = 0>
+class DijkstraEngine {
+public:
+    const SearchResult &run(const Graph &graph, int startNode); // Settles every node reachable from startNode
+
+private:
+    SearchResult result; // Output of the last run
+    std::conditional_t<(MaxWeight > 0), DialQueue<MaxWeight>, RadixHeap> queue; // Priority queue of unsettled nodes
+};
+
+template <int MaxWeight>
+const SearchResult &DijkstraEngine<MaxWeight>::run(const Graph &graph, int startNode) {
+    const int numNodes = graph.nodeCount();
+    result.distance.assign(numNodes, Unreachable);
+    result.predecessor.assign(numNodes, -1);
+    result.predecessorEdge.assign(numNodes, -1);
+    result.pathCount.assign(numNodes, 0);
+    result.settled = 0;
+    if constexpr (MaxWeight > 0) {
+        queue.reset(numNodes);
+    } else {
+        queue.reset();
+    }
+
+    result.distance[startNode] = 0;
+    result.pathCount[startNode] = 1;
+    queue.push(startNode, 0);
+
+    while (!queue.empty()) {
+        auto [currNode, currDist] = queue.pop();
+
+        // The radix heap keeps stale entries instead of moving them
+        if constexpr (MaxWeight == 0) {
+            if (currDist > result.distance[currNode]) {
+                continue;
+            }
+        }
+        result.settled++;
+
+        // Relax the arcs leaving the current node
+        for (const Arc &arc : graph.outArcs(currNode)) {
+            int newDist = currDist + arc.weight;
+            int oldDist = result.distance[arc.node];
+            if (newDist < oldDist) {
+                result.distance[arc.node] = newDist;
+                result.predecessor[arc.node] = currNode;
+                result.predecessorEdge[arc.node] = arc.edge;
+                result.pathCount[arc.node] = result.pathCount[currNode];
+                if constexpr (MaxWeight > 0) {
+                    if (oldDist == Unreachable) {
+                        queue.push(arc.node, newDist);
+                    } else {
+                        queue.update(arc.node, oldDist, newDist);
+                    }
+                } else {
+                    queue.push(arc.node, newDist);
+                }
+            } else if (newDist == oldDist) {
+                // Another route as short as the best so far
+                int &count = result.pathCount[arc.node];
+                count = int(std::min<long long>(MaxPathCount, (long long)count + result.pathCount[currNode]));
+            }
+        }
+    }
+
+    return result;
+}
+
+// Dijkstra's algorithm from a start node, using the bucket queue when the weights fit the generator's bound
+SearchResult dijkstra(const Graph &graph, int startNode);
+
+// Edge ids along the shortest path from the search's start node to endNode, in travel order
+std::vector<int> pathEdges(const SearchResult &result, int endNode);
+
+// Answer to the query from the search's start node to endNode, read off a finished search
+PathResult pathTo(const SearchResult &result, int endNode);
+
+// Reroutes the tree along a shortest path from its start node, given as edge ids in travel order, so
+// the tree's path to every node on it is that path
+void followPath(const Graph &graph, SearchResult &result, int startNode, const std::vector<int> &edges);
+
+// Up to limit of the shortest paths from the search's start node to endNode, as edge ids in travel order.
+// They are read off the arcs that keep the distance tight, so the search must have settled endNode.
+std::vector<std::vector<int>> tiedPaths(const Graph &graph, const SearchResult &result, int endNode, int limit);
+
+// Bidirectional Dijkstra, stopping once the two frontiers can no longer improve the best meeting path
+PathResult bidirectionalDijkstra(const Graph &graph, int startNode, int endNode);
+
+// A* search with a pluggable heuristic, which must never overestimate and must be consistent
+template <class Heuristic>
+PathResult aStar(const Graph &graph, int startNode, int endNode, const Heuristic &heuristic) {
+    using MinQueue = std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<std::pair<int, int>>>;
+    const int numNodes = graph.nodeCount();
+    std::vector<int> distance(numNodes, Unreachable);
+    std::vector<int> parentEdge(numNodes, -1);
+    std::vector<int> parentNode(numNodes, -1);
+    std::vector<bool> settled(numNodes, false);
+    MinQueue queue;
+
+    PathResult result;
+    distance[startNode] = 0;
+    queue.push({heuristic(startNode), startNode});
+
+    while (!queue.empty()) {
+        int currNode = queue.top().second;
+        queue.pop();
+        if (settled[currNode]) {
+            continue;
+        }
+        settled[currNode] = true;
+        result.settled++;
+        if (currNode == endNode) {
+            break;
+        }
+
+        // Relax the arcs leaving the current node, ordering the queue by distance plus estimate
+        for (const Arc &arc : graph.outArcs(currNode)) {
+            int newDist = distance[currNode] + arc.weight;
+            if (newDist < distance[arc.node]) {
+                distance[arc.node] = newDist;
+                parentEdge[arc.node] = arc.edge;
+                parentNode[arc.node] = currNode;
+                queue.push({newDist + heuristic(arc.node), arc.node});
+            }
+        }
+    }
+
+    result.distance = distance[endNode];
+    if (result.distance != Unreachable) {
+        for (int node = endNode; node != startNode; node = parentNode[node]) {
+            result.edges.push_back(parentEdge[node]);
+        }
+        std::reverse(result.edges.begin(), result.edges.end());
+    }
+    return result;
+}
+
+// Answers a start -> end query with the chosen strategy
+PathResult shortestPath(const Graph &graph, int startNode, int endNode, SolverMode mode);
+
+#endif // SHORTESTPATH_H
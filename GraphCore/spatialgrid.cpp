@@ -0,0 +1,59 @@
+#include "spatialgrid.h"
+
+// SpatialGrid constructor sizes the grid to the points' bounds and sorts the point ids into cells
+SpatialGrid::SpatialGrid(const std::vector<Point> &points, double cellSize)
+    : points(points), cellSize(cellSize > 0 ? cellSize : 1.0)
+{
+    if (!points.empty()) {
+        double maxX = points[0].x;
+        double maxY = points[0].y;
+        originX = points[0].x;
+        originY = points[0].y;
+        for (const Point &p : points) {
+            originX = std::min(originX, p.x);
+            originY = std::min(originY, p.y);
+            maxX = std::max(maxX, p.x);
+            maxY = std::max(maxY, p.y);
+        }
+        columns = int((maxX - originX) / this->cellSize) + 1;
+        rows = int((maxY - originY) / this->cellSize) + 1;
+    }
+
+    // Counting sort of the ids by cell
+    std::vector<int> cells(points.size());
+    cellOffsets.assign(size_t(columns) * rows + 1, 0);
+    for (int id = 0; id < int(points.size()); id++) {
+        cells[id] = row(points[id].y) * columns + column(points[id].x);
+        cellOffsets[cells[id] + 1]++;
+    }
+    for (size_t cell = 1; cell < cellOffsets.size(); cell++) {
+        cellOffsets[cell] += cellOffsets[cell - 1];
+    }
+    cellIds.resize(points.size());
+    std::vector<int> next(cellOffsets.begin(), cellOffsets.end() - 1);
+    for (int id = 0; id < int(points.size()); id++) {
+        cellIds[next[cells[id]]++] = id;
+    }
+}
+
+// Returns the number of indexed points
+int SpatialGrid::pointCount() const {
+    return int(points.size());
+}
+
+// Returns the position of an indexed point
+const Point &SpatialGrid::point(int id) const {
+    return points[id];
+}
+
+// Maps an x coordinate to its cell column, clamping positions outside the grid to the border cells
+int SpatialGrid::column(double x) const {
+    const double c = std::floor((x - originX) / cellSize);
+    return c < 0 ? 0 : (c >= columns ? columns - 1 : int(c));
+}
+
+// Maps a y coordinate to its cell row, clamping positions outside the grid to the border cells
+int SpatialGrid::row(double y) const {
+    const double r = std::floor((y - originY) / cellSize);
+    return r < 0 ? 0 : (r >= rows ? rows - 1 : int(r));
+}
@@ -0,0 +1,119 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include "geometry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Uniform grid over a set of points for proximity queries. Points are bucketed by cell in one flat
+// array, so a query only looks at the points in the cells its search area overlaps. Queries report
+// candidates; callers apply the exact distance test.
+class SpatialGrid {
+public:
+    SpatialGrid(const std::vector<Point> &points, double cellSize);
+
+    int pointCount() const; // Number of indexed points
+    const Point &point(int id) const; // Position of an indexed point
+
+    // Calls visit(id) for every point whose cell overlaps the disc around a centre
+    template<class Visit>
+    void forEachNearPoint(const Point &centre, double radius, Visit &&visit) const;
+
+    // Calls visit(id) for every point whose cell overlaps the area within radius of a segment.
+    // Each row of cells is clipped to the part of the segment that can reach it, so a long
+    // diagonal segment only visits the cells it passes through.
+    template<class Visit>
+    void forEachNearSegment(const Segment &segment, double radius, Visit &&visit) const;
+
+    // Calls visit(id) for every point whose cell overlaps the rectangle between two corners
+    template<class Visit>
+    void forEachInRect(const Point &topLeft, const Point &bottomRight, Visit &&visit) const;
+
+private:
+    int column(double x) const; // Cell column of an x coordinate, clamped to the grid
+    int row(double y) const; // Cell row of a y coordinate, clamped to the grid
+    template<class Visit>
+    void visitCells(int row, int firstColumn, int lastColumn, Visit &visit) const; // Visits the points of a run of cells
+
+    std::vector<Point> points; // Indexed points by id
+    double originX = 0; // Left edge of the grid
+    double originY = 0; // Top edge of the grid
+    double cellSize; // Width and height of a cell
+    int columns = 1; // Number of cell columns
+    int rows = 1; // Number of cell rows
+    std::vector<int> cellOffsets; // Start of each cell's ids in cellIds, one extra entry at the end
+    std::vector<int> cellIds; // Point ids grouped by cell
+};
+
+// Widens a query radius slightly so rounding never drops a cell the exact test would accept
+inline double paddedRadius(double radius) {
+    return radius * (1 + 1e-9) + 1e-9;
+}
+
+template<class Visit>
+void SpatialGrid::forEachNearPoint(const Point &centre, double radius, Visit &&visit) const {
+    const double r = paddedRadius(radius);
+    const int lastRow = row(centre.y + r);
+    const int firstColumn = column(centre.x - r);
+    const int lastColumn = column(centre.x + r);
+    for (int y = row(centre.y - r); y <= lastRow; y++) {
+        visitCells(y, firstColumn, lastColumn, visit);
+    }
+}
+
+template<class Visit>
+void SpatialGrid::forEachNearSegment(const Segment &segment, double radius, Visit &&visit) const {
+    const double r = paddedRadius(radius);
+    const double dx = segment.p2.x - segment.p1.x;
+    const double dy = segment.p2.y - segment.p1.y;
+    const int firstRow = row(std::min(segment.p1.y, segment.p2.y) - r);
+    const int lastRow = row(std::max(segment.p1.y, segment.p2.y) + r);
+
+    for (int y = firstRow; y <= lastRow; y++) {
+        // Only points of the segment within r of this row's band can reach a cell in it
+        const double bandTop = originY + y * cellSize - r;
+        const double bandBottom = originY + (y + 1) * cellSize + r;
+        double t0 = 0;
+        double t1 = 1;
+        if (dy == 0) {
+            if (segment.p1.y < bandTop || segment.p1.y > bandBottom) {
+                continue;
+            }
+        } else {
+            double tTop = (bandTop - segment.p1.y) / dy;
+            double tBottom = (bandBottom - segment.p1.y) / dy;
+            t0 = std::max(0.0, std::min(tTop, tBottom));
+            t1 = std::min(1.0, std::max(tTop, tBottom));
+            if (t0 > t1) {
+                continue;
+            }
+        }
+
+        const double x0 = segment.p1.x + dx * t0;
+        const double x1 = segment.p1.x + dx * t1;
+        visitCells(y, column(std::min(x0, x1) - r), column(std::max(x0, x1) + r), visit);
+    }
+}
+
+template<class Visit>
+void SpatialGrid::forEachInRect(const Point &topLeft, const Point &bottomRight, Visit &&visit) const {
+    const int lastRow = row(bottomRight.y);
+    const int firstColumn = column(topLeft.x);
+    const int lastColumn = column(bottomRight.x);
+    for (int y = row(topLeft.y); y <= lastRow; y++) {
+        visitCells(y, firstColumn, lastColumn, visit);
+    }
+}
+
+template<class Visit>
+void SpatialGrid::visitCells(int row, int firstColumn, int lastColumn, Visit &visit) const {
+    const int first = cellOffsets[row * columns + firstColumn];
+    const int last = cellOffsets[row * columns + lastColumn + 1];
+    for (int i = first; i < last; i++) {
+        visit(cellIds[i]);
+    }
+}
+
+#endif // SPATIALGRID_H
@@ -0,0 +1,117 @@
+#include "workstealingpool.h"
+
+#include <algorithm>
+
+// WorkStealingPool constructor starts the worker threads
+WorkStealingPool::WorkStealingPool(int numThreads) {
+    if (numThreads <= 0) {
+        numThreads = std::max(1, int(std::thread::hardware_concurrency()));
+    }
+    for (int i = 0; i < numThreads; i++) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (int i = 0; i < numThreads; i++) {
+        threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+// WorkStealingPool destructor stops and joins the worker threads
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+// Returns the number of worker threads
+int WorkStealingPool::threadCount() const {
+    return int(threads.size());
+}
+
+// Deals the indices out in contiguous blocks, wakes the workers and waits until every task has run
+void WorkStealingPool::parallelFor(int begin, int end, const std::function<void(int, int)> &task) {
+    if (begin >= end) {
+        return;
+    }
+
+    const int numTasks = end - begin;
+    const int numWorkers = threadCount();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &task;
+        remaining = numTasks;
+    }
+    for (int w = 0; w < numWorkers; w++) {
+        int first = begin + int(int64_t(numTasks) * w / numWorkers);
+        int last = begin + int(int64_t(numTasks) * (w + 1) / numWorkers);
+        std::lock_guard<std::mutex> lock(queues[w]->mutex);
+        for (int i = first; i < last; i++) {
+            queues[w]->indices.push_back(i);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        generation++;
+    }
+    wake.notify_all();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this]() { return remaining == 0; });
+}
+
+// Waits for a loop to start, then runs tasks from the local queue and steals once it is empty
+void WorkStealingPool::workerLoop(int worker) {
+    uint64_t seenGeneration = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&]() { return stopping || generation != seenGeneration; });
+            if (stopping) {
+                return;
+            }
+            seenGeneration = generation;
+        }
+
+        // The job is read after taking an index, since a worker still draining the previous loop may pick
+        // up an index of the next one, and the job is always published before its indices are queued
+        int index;
+        while (takeLocal(worker, index) || steal(worker, index)) {
+            (*job)(index, worker);
+            if (--remaining == 0) {
+                std::lock_guard<std::mutex> lock(mutex);
+                done.notify_all();
+            }
+        }
+    }
+}
+
+// Takes the next index from the front of the worker's own queue
+bool WorkStealingPool::takeLocal(int worker, int &index) {
+    WorkQueue &queue = *queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.indices.empty()) {
+        return false;
+    }
+    index = queue.indices.front();
+    queue.indices.pop_front();
+    return true;
+}
+
+// Visits the other workers in turn and takes an index from the back of the first non-empty queue
+bool WorkStealingPool::steal(int thief, int &index) {
+    const int numWorkers = threadCount();
+    for (int offset = 1; offset < numWorkers; offset++) {
+        WorkQueue &queue = *queues[(thief + offset) % numWorkers];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.indices.empty()) {
+            index = queue.indices.back();
+            queue.indices.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
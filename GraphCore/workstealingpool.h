@@ -0,0 +1,52 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel loops. Each worker starts with a contiguous block of
+// indices and takes work from the front of its own deque; a worker that runs dry steals from the back
+// of another worker's deque, so uneven task costs still keep every thread busy.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int numThreads = 0); // 0 uses one thread per hardware thread
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    int threadCount() const; // Number of worker threads
+
+    // Runs task(index, worker) for every index in [begin, end) and waits for all of them to finish
+    void parallelFor(int begin, int end, const std::function<void(int index, int worker)> &task);
+
+private:
+    // Task indices owned by one worker
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<int> indices;
+    };
+
+    void workerLoop(int worker); // Body of each worker thread
+    bool takeLocal(int worker, int &index); // Takes the next index from a worker's own queue
+    bool steal(int thief, int &index); // Takes an index from the back of another worker's queue
+
+    std::vector<std::unique_ptr<WorkQueue>> queues; // One queue per worker
+    std::vector<std::thread> threads; // Worker threads
+    std::mutex mutex; // Guards generation, job and stopping
+    std::condition_variable wake; // Signals workers that a new loop started
+    std::condition_variable done; // Signals parallelFor that every task finished
+    const std::function<void(int, int)> *job = nullptr; // Task of the current loop
+    uint64_t generation = 0; // Incremented for every loop
+    std::atomic<int> remaining{0}; // Tasks of the current loop still to finish
+    bool stopping = false; // Set when the pool is destroyed
+};
+
+#endif // WORKSTEALINGPOOL_H
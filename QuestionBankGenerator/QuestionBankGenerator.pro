@@ -0,0 +1,16 @@
+QT += core
+QT -= gui
+
+# Define the target
+TARGET = QuestionBankGenerator
+TEMPLATE = app
+
+# Headless console application
+CONFIG += console c++17
+CONFIG -= app_bundle
+
+# Add the source and header files
+SOURCES += main.cpp
+
+# Headless graph core
+include(../GraphCore/GraphCore.pri)
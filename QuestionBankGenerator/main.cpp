@@ -0,0 +1,189 @@
+#include "question.h"
+#include "questionbank.h"
+#include "workstealingpool.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QStringList>
+#include <QTextStream>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+// Headless question bank generator. Every question is generated from its own seed, so a seed range
+// always produces the same questions no matter how many threads or processes share the work.
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("QuestionBankGenerator");
+
+    // Describe the command line options
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Pre-generates Dijkstra quiz questions for a range of seeds.");
+    parser.addHelpOption();
+    QCommandLineOption firstSeedOption({"s", "first-seed"}, "First seed of the range.", "seed", "1");
+    QCommandLineOption countOption({"n", "count"}, "Number of questions, one per seed.", "count", "1000");
+    QCommandLineOption threadsOption({"j", "threads"}, "Worker threads, 0 for one per core.", "threads", "0");
+    QCommandLineOption graphTypeOption({"t", "graph-type"}, "Graph type: basic, advanced or large.", "type", "basic");
+    QCommandLineOption directedOption({"d", "directed"}, "Allow directed edges.");
+    QCommandLineOption lengthWeightsOption({"l", "length-weights"}, "Make edge weights proportional to edge length.");
+    QCommandLineOption solverOption("solver", "Solver: dijkstra, bidirectional, astar or deltastepping.", "solver", "dijkstra");
+    QCommandLineOption uniqueOption({"u", "unique"}, "Regenerate graphs with more than one shortest path.");
+    QCommandLineOption quizOption("quiz", "Quiz mode: path, distance or multi.", "mode", "path");
+    QCommandLineOption labelsOption("labels", "Node labels: letters or numbers, numbers by default for large graphs.", "style");
+    QCommandLineOption outputOption({"o", "output"}, "File to write the questions to.", "file");
+    QCommandLineOption bankOption({"b", "bank"}, "Binary question bank to write, for the visualiser to map.", "file");
+    parser.addOptions({firstSeedOption, countOption, threadsOption, graphTypeOption, directedOption,
+                       lengthWeightsOption, solverOption, uniqueOption, quizOption, labelsOption, outputOption, bankOption});
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    // Read the seed range and pipeline options
+    bool seedOk = false, countOk = false, threadsOk = false;
+    const quint64 firstSeed = parser.value(firstSeedOption).toULongLong(&seedOk);
+    const int count = parser.value(countOption).toInt(&countOk);
+    const int threads = parser.value(threadsOption).toInt(&threadsOk);
+    if (!seedOk || !countOk || count < 0 || !threadsOk) {
+        err << "Invalid seed range or thread count" << Qt::endl;
+        return 1;
+    }
+
+    // Each name list is in the order of its enum; an unknown name stops the run rather than falling
+    // back to a default, so a mistyped option cannot fill a bank with the wrong questions
+    const QStringList graphTypes{"basic", "advanced", "large"};
+    const QStringList quizModes{"path", "distance", "multi"};
+    const QStringList solvers{"dijkstra", "bidirectional", "astar", "deltastepping"};
+    const QStringList labelStyles{"letters", "numbers"};
+    const int graphType = graphTypes.indexOf(parser.value(graphTypeOption));
+    const int quizMode = quizModes.indexOf(parser.value(quizOption));
+    const int solver = solvers.indexOf(parser.value(solverOption));
+    const int labelStyle = parser.isSet(labelsOption) ? labelStyles.indexOf(parser.value(labelsOption)) : int(graphType == 2 ? LabelStyle::Numbers : LabelStyle::Letters);
+    if (graphType == -1 || quizMode == -1 || solver == -1 || labelStyle == -1) {
+        if (graphType == -1) {
+            err << "Unknown graph type " << parser.value(graphTypeOption) << ", expected " << graphTypes.join(", ") << Qt::endl;
+        }
+        if (quizMode == -1) {
+            err << "Unknown quiz mode " << parser.value(quizOption) << ", expected " << quizModes.join(", ") << Qt::endl;
+        }
+        if (solver == -1) {
+            err << "Unknown solver " << parser.value(solverOption) << ", expected " << solvers.join(", ") << Qt::endl;
+        }
+        if (labelStyle == -1) {
+            err << "Unknown label style " << parser.value(labelsOption) << ", expected " << labelStyles.join(", ") << Qt::endl;
+        }
+        return 1;
+    }
+
+    GeneratorConfig config;
+    config.graphType = graphType;
+    if (graphType == 2) {
+        // Large graphs span the same scrollable scene as in the visualiser
+        config.sceneWidth = 4000;
+        config.sceneHeight = 2400;
+    }
+    config.directed = parser.isSet(directedOption);
+    config.proportionalWeights = parser.isSet(lengthWeightsOption);
+    config.quizMode = static_cast<QuizMode>(quizMode);
+    config.labelStyle = static_cast<LabelStyle>(labelStyle);
+    config.uniqueAnswers = parser.isSet(uniqueOption);
+    const SolverMode mode = static_cast<SolverMode>(solver);
+
+    // Open the outputs before any work is done, so a bad path fails straight away
+    QFile file(parser.value(outputOption));
+    QTextStream stream(&file);
+    if (parser.isSet(outputOption) && !file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        err << "Could not open " << file.fileName() << Qt::endl;
+        return 1;
+    }
+    std::unique_ptr<QuestionBankWriter> writer;
+    if (parser.isSet(bankOption)) {
+        writer = std::make_unique<QuestionBankWriter>(parser.value(bankOption).toStdString());
+        if (!writer->isOpen()) {
+            err << "Could not write " << parser.value(bankOption) << Qt::endl;
+            return 1;
+        }
+    }
+
+    // Generate the questions on the thread pool, each worker keeping its own stage timings. Seeds are
+    // handed out a window at a time and each finished window is written in seed order, so only one
+    // window of questions is held in memory however many are asked for.
+    QuestionPipeline pipeline(config, mode);
+    WorkStealingPool pool(threads);
+    const int window = pool.threadCount() * 32;
+    std::vector<Question> questions(std::min(count, window));
+    std::vector<StageTimings> workerTimings(pool.threadCount());
+    std::vector<int> workerAttempts(pool.threadCount(), 0);
+    std::vector<int> workerAmbiguous(pool.threadCount(), 0);
+    std::vector<qint64> workerSettled(pool.threadCount(), 0);
+    std::vector<qint64> workerNodes(pool.threadCount(), 0);
+
+    qint64 elapsedNs = 0;
+    bool written = true;
+    for (int first = 0; first < count; first += window) {
+        const int size = std::min(window, count - first);
+        QElapsedTimer timer;
+        timer.start();
+        pool.parallelFor(0, size, [&](int index, int worker) {
+            questions[index] = pipeline.generate(firstSeed + quint64(first + index), &workerTimings[worker]);
+            workerAttempts[worker] += questions[index].attempts;
+            workerAmbiguous[worker] += questions[index].optimalPaths > 1;
+            workerSettled[worker] += questions[index].path.settled;
+            workerNodes[worker] += questions[index].graph.nodeCount();
+        });
+        elapsedNs += timer.nsecsElapsed();
+
+        // Write the window in seed order, as text and as a bank the visualiser can map
+        for (int index = 0; index < size; index++) {
+            const Question &question = questions[index];
+            if (file.isOpen()) {
+                QStringList distractors;
+                for (const std::string &distractor : question.distractors) {
+                    distractors.append(QString::fromStdString(distractor));
+                }
+                stream << question.seed << '\t' << QString::fromStdString(question.answer) << '\t'
+                       << question.path.distance << '\t' << distractors.join(',') << '\n';
+            }
+            if (writer && written) {
+                written = writer->add(question, config);
+            }
+        }
+    }
+    if (writer && (!writer->finish() || !written)) {
+        err << "Could not write " << parser.value(bankOption) << Qt::endl;
+        return 1;
+    }
+
+    // Report throughput and where the time went
+    StageTimings total;
+    int attempts = 0;
+    int ambiguous = 0;
+    qint64 settled = 0;
+    qint64 nodes = 0;
+    for (int w = 0; w < pool.threadCount(); w++) {
+        total += workerTimings[w];
+        attempts += workerAttempts[w];
+        ambiguous += workerAmbiguous[w];
+        settled += workerSettled[w];
+        nodes += workerNodes[w];
+    }
+    const double seconds = elapsedNs / 1e9;
+    const double perQuestion = count > 0 ? 1.0 / count : 0.0;
+    out << "Generated " << count << " questions (seeds " << firstSeed << ".." << firstSeed + quint64(count) - 1
+        << ") on " << pool.threadCount() << " threads in " << QString::number(seconds, 'f', 3) << " s" << Qt::endl;
+    out << "Throughput: " << QString::number(seconds > 0 ? count / seconds : 0.0, 'f', 1) << " questions/sec" << Qt::endl;
+    out << "Attempts per question: " << QString::number(attempts * perQuestion, 'f', 2) << Qt::endl;
+    out << "Questions with tied shortest paths: " << ambiguous << Qt::endl;
+    out << "Nodes settled by the solver per question: " << QString::number(settled * perQuestion, 'f', 1) << " of "
+        << QString::number(nodes * perQuestion, 'f', 1) << Qt::endl;
+    out << "Stage timings (mean per question, summed over threads):" << Qt::endl;
+    out << "  generate    " << QString::number(total.generate * perQuestion / 1e3, 'f', 1) << " us" << Qt::endl;
+    out << "  prune       " << QString::number(total.prune * perQuestion / 1e3, 'f', 1) << " us" << Qt::endl;
+    out << "  solve       " << QString::number(total.solve * perQuestion / 1e3, 'f', 1) << " us" << Qt::endl;
+    out << "  distractors " << QString::number(total.distractors * perQuestion / 1e3, 'f', 1) << " us" << Qt::endl;
+
+    return 0;
+}